@@ -8,14 +8,32 @@ int main(int argc, char** argv) {
     Boolean configUploadFlag = False;
     Boolean mdDisplayFlag = False;
     Boolean runSimFlag = False;
+    Boolean virtualTimeFlag = False;
+    Boolean streamFlag = False;
+    Boolean forceCompileFlag = False;
+    Boolean logDropFlag = False;
     Boolean infoFlag = False;
+    Boolean schedCompareFlag = False;
+    Boolean overheadFlag = False;
+    int memAllocCode = MEM_ALLOC_NONE_CODE;
+    int pageSize = 0;
+    int pageReplaceCode = PAGE_REPLACE_LRU_CODE;
+    int pageFaultCycles = 1;
+    int metricsCode = METRICS_NONE_CODE;
+    int batchThreadCount = 0;
+    SweepType sweeps[MAX_SWEEP_COUNT];
+    int sweepCount = 0;
+    char flagValue[STD_STR_LEN];
     int argIndex = 1;
-    int lastFourLetters = 4;
-    int fileStrLen, fileStrSubLoc;
-    char fileName[STD_STR_LEN];
+    int configIndex;
+    char **configFileNames = NULL;
+    int configCount = 0;
     char errorMessage[MAX_STR_LEN];
+    ConfigDataType **configDataPtrs = NULL;
     ConfigDataType *configDataPtr = NULL;
-    OpCodeType *metaDataPtr = NULL;
+    OpProgramType *metaDataPtr = NULL;
+    MetaDataStreamType *metaDataStreamPtr = NULL;
+    BatchType *batchPtr = NULL;
     // show title
     printf("\nSimulator Program\n");
     printf("=================\n\n");
@@ -30,15 +48,8 @@ int main(int argc, char** argv) {
         infoFlag = True;
     }
 
-    // initialize file name to empty
-    fileName[0] = NULL_CHAR;
-
     // loop across args and program run flag
     while (programRunFlag == False && argIndex < argc) {
-        // find lengths to verify file name
-        fileStrLen = getStringLength(argv[argIndex]);
-        fileStrSubLoc = findSubString(argv[argIndex], ".cnf");
-
         // check for -dc display config flag
         if (compareString(argv[argIndex], "-dc") == STR_EQ) {
             // set config upload flag
@@ -60,11 +71,143 @@ int main(int argc, char** argv) {
             // set run simulator flag
             runSimFlag = True;
         }
+        // otherwise, check for -vt run simulator in virtual time
+        else if (compareString(argv[argIndex], "-vt") == STR_EQ) {
+            // set config upload flag
+            configUploadFlag = True;
+            // set run simulator flag
+            runSimFlag = True;
+            // set virtual time flag
+            virtualTimeFlag = True;
+        }
+        // otherwise, check for -st run simulator while streaming meta data
+        else if (compareString(argv[argIndex], "-st") == STR_EQ) {
+            // set config upload flag
+            configUploadFlag = True;
+            // set run simulator flag
+            runSimFlag = True;
+            // set stream flag
+            streamFlag = True;
+        }
+        // otherwise, check for -rc recompile meta data cache
+        else if (compareString(argv[argIndex], "-rc") == STR_EQ) {
+            // set force compile flag
+            forceCompileFlag = True;
+        }
+        // otherwise, check for -ld drop log lines when the log falls behind
+        else if (compareString(argv[argIndex], "-ld") == STR_EQ) {
+            // set log drop flag
+            logDropFlag = True;
+        }
+        // otherwise, check for -mb model a buddy allocator
+        else if (compareString(argv[argIndex], "-mb") == STR_EQ) {
+            // set memory allocator
+            memAllocCode = MEM_ALLOC_BUDDY_CODE;
+        }
+        // otherwise, check for -ms model a segregated free-list allocator
+        else if (compareString(argv[argIndex], "-ms") == STR_EQ) {
+            // set memory allocator
+            memAllocCode = MEM_ALLOC_SEGREGATED_CODE;
+        }
+        // otherwise, check for -pg page size, turning paging on
+        else if (compareString(argv[argIndex], "-pg") == STR_EQ) {
+            // get page size in KB, check for failure
+            if (getFlagNumber(argc, argv, &argIndex, &pageSize) == False || pageSize < 1) {
+                // stop reading args, leaving the program run flag unset
+                argIndex = argc;
+            }
+        }
+        // otherwise, check for -pr page replacement policy
+        else if (compareString(argv[argIndex], "-pr") == STR_EQ) {
+            // get lower case policy name, if there is one
+            flagValue[0] = NULL_CHAR;
+            if (argIndex + 1 < argc && getStringLength(argv[argIndex + 1]) < STD_STR_LEN) {
+                argIndex++;
+                setStrToLowerCase(flagValue, argv[argIndex]);
+            }
+            // set page replacement policy
+            if (compareString(flagValue, "fifo") == STR_EQ) {
+                pageReplaceCode = PAGE_REPLACE_FIFO_CODE;
+            } else if (compareString(flagValue, "lru") == STR_EQ) {
+                pageReplaceCode = PAGE_REPLACE_LRU_CODE;
+            } else if (compareString(flagValue, "clock") == STR_EQ) {
+                pageReplaceCode = PAGE_REPLACE_CLOCK_CODE;
+            } else {
+                // stop reading args, leaving the program run flag unset
+                argIndex = argc;
+            }
+        }
+        // otherwise, check for -pf page fault cost
+        else if (compareString(argv[argIndex], "-pf") == STR_EQ) {
+            // get I/O cycles per page fault, check for failure
+            if (getFlagNumber(argc, argv, &argIndex, &pageFaultCycles) == False || pageFaultCycles < 0) {
+                // stop reading args, leaving the program run flag unset
+                argIndex = argc;
+            }
+        }
+        // otherwise, check for -pm display process metrics, optionally written as csv or json
+        else if (compareString(argv[argIndex], "-pm") == STR_EQ) {
+            // display process metrics
+            metricsCode = METRICS_DISPLAY_CODE;
+            // get lower case format name, if one follows
+            flagValue[0] = NULL_CHAR;
+            if (argIndex + 1 < argc && getStringLength(argv[argIndex + 1]) < STD_STR_LEN) {
+                setStrToLowerCase(flagValue, argv[argIndex + 1]);
+            }
+            // set metrics file format, taking the format name
+            if (compareString(flagValue, "csv") == STR_EQ) {
+                metricsCode = METRICS_CSV_CODE;
+                argIndex++;
+            } else if (compareString(flagValue, "json") == STR_EQ) {
+                metricsCode = METRICS_JSON_CODE;
+                argIndex++;
+            }
+        }
+        // otherwise, check for -oh record simulator overhead
+        else if (compareString(argv[argIndex], "-oh") == STR_EQ) {
+            // set overhead flag
+            overheadFlag = True;
+        }
+        // otherwise, check for -bt run a batch of simulations on a pool of threads
+        else if (compareString(argv[argIndex], "-bt") == STR_EQ) {
+            // set config upload flag
+            configUploadFlag = True;
+            // get thread count, check for failure
+            if (getFlagNumber(argc, argv, &argIndex, &batchThreadCount) == False
+                || batchThreadCount < 1 || batchThreadCount > MAX_BATCH_THREADS) {
+                // stop reading args, leaving the program run flag unset
+                argIndex = argc;
+            }
+        }
+        // otherwise, check for -sc compare every cpu scheduling code in virtual time
+        else if (compareString(argv[argIndex], "-sc") == STR_EQ) {
+            // set config upload flag
+            configUploadFlag = True;
+            // set virtual time flag
+            virtualTimeFlag = True;
+            // set scheduler compare flag
+            schedCompareFlag = True;
+        }
+        // otherwise, check for -sw sweep a config item over a value list
+        else if (compareString(argv[argIndex], "-sw") == STR_EQ) {
+            // get config prompt and value list, check for failure
+            if (argIndex + 2 >= argc || sweepCount == MAX_SWEEP_COUNT
+                || parseSweep(&sweeps[sweepCount], argv[argIndex + 1], argv[argIndex + 2]) == False) {
+                // stop reading args, leaving the program run flag unset
+                argIndex = argc;
+            }
+            // otherwise, keep the sweep and move past its args
+            else {
+                sweepCount++;
+                argIndex += 2;
+            }
+        }
         // otherwise, check for file name, ending in .cnf
         // must be last flag
-        else if (fileStrSubLoc != SUBSTRING_NOT_FOUND && fileStrSubLoc == fileStrLen - lastFourLetters) {
-            // set file name to variable
-            copyString(fileName, argv[argIndex]);
+        else if (isConfigFileName(argv[argIndex]) == True) {
+            // set config file names, only the one unless running a batch
+            configFileNames = &argv[argIndex];
+            configCount = 1;
             // set program run flag
             programRunFlag = True;
         }
@@ -73,6 +216,44 @@ int main(int argc, char** argv) {
     }
     // end arg loop
 
+    // check for scheduler comparison, a batch sweeping every cpu scheduling code
+    if (programRunFlag == True && schedCompareFlag == True) {
+        // check for no room left for the scheduler sweep
+        if (sweepCount == MAX_SWEEP_COUNT) {
+            // unset program run flag
+            programRunFlag = False;
+        }
+        // otherwise, add the scheduler sweep
+        else {
+            setSchedulerSweep(&sweeps[sweepCount]);
+            // run a thread per scheduler, unless -bt says otherwise
+            if (batchThreadCount == 0) {
+                batchThreadCount = sweeps[sweepCount].valueCount;
+            }
+            sweepCount++;
+        }
+    }
+    // check for batch mode, which takes every arg after the first config file name as another one
+    if (programRunFlag == True && batchThreadCount > 0) {
+        // loop across the remaining args
+        while (argIndex < argc) {
+            // check for an arg that is not a config file name
+            if (isConfigFileName(argv[argIndex]) == False) {
+                // unset program run flag
+                programRunFlag = False;
+            }
+            // count config file name
+            configCount++;
+            // update arg index
+            argIndex++;
+        }
+    }
+    // otherwise, check for sweeps without batch mode
+    else if (sweepCount > 0) {
+        // unset program run flag
+        programRunFlag = False;
+    }
+
     // check for command line failure
     if (programRunFlag == False && infoFlag == False) {
         // show error message, end program
@@ -83,8 +264,36 @@ int main(int argc, char** argv) {
 
     // check for program run and config upload flag
     if (programRunFlag == True && configUploadFlag == True) {
+        // create config data list
+        configDataPtrs = calloc(configCount, sizeof(ConfigDataType *));
+    }
+    // loop across config files while the uploads succeed
+    for (configIndex = 0; programRunFlag == True && configDataPtrs != NULL && configIndex < configCount;
+         configIndex++) {
         // upload config file, check for success
-        if (getStringLength(fileName) > 0 && getConfigData(fileName, &configDataPtr, errorMessage) == True) {
+        if (getConfigData(configFileNames[configIndex], &configDataPtr, errorMessage) == True) {
+            // add config data to list
+            configDataPtrs[configIndex] = configDataPtr;
+            // check virtual time flag
+            if (virtualTimeFlag == True) {
+                // run the simulator on the simulated clock
+                configDataPtr->clockModeCode = CLOCK_VIRTUAL_CODE;
+            }
+            // check log drop flag
+            if (logDropFlag == True) {
+                // drop log lines instead of waiting for the log writer
+                configDataPtr->logFullCode = LOG_FULL_DROP_CODE;
+            }
+            // set the physical allocator to model, if any
+            configDataPtr->memAllocCode = memAllocCode;
+            // set paging, off while the page size is 0
+            configDataPtr->pageSize = pageSize;
+            configDataPtr->pageReplaceCode = pageReplaceCode;
+            configDataPtr->pageFaultCycles = pageFaultCycles;
+            // set process metrics, off unless asked for
+            configDataPtr->metricsCode = metricsCode;
+            // set overhead recording, off unless asked for
+            configDataPtr->recordOverhead = overheadFlag;
             // check config display flag
             if (configDisplayFlag == True) {
                 // display config data
@@ -99,10 +308,62 @@ int main(int argc, char** argv) {
             programRunFlag = False;
         }
     }
-    // check for program run flag
-    if (programRunFlag == True && (mdDisplayFlag == True || runSimFlag == True))  {
+    // check for program run and batch mode
+    if (programRunFlag == True && batchThreadCount > 0) {
+        // expand configs and sweeps into runs, then load their meta data, check for success
+        batchPtr = createBatch(configDataPtrs, configFileNames, configCount, sweeps, sweepCount, errorMessage);
+        if (batchPtr != NULL && loadBatchMetaData(batchPtr, forceCompileFlag, errorMessage) == True) {
+            // run the batch
+            runBatch(batchPtr, batchThreadCount);
+            // check scheduler compare flag
+            if (schedCompareFlag == True) {
+                // display the scheduling metrics of every run
+                displaySchedulerComparison(batchPtr);
+            }
+            // otherwise, assume a plain batch
+            else {
+                // display the results of every run
+                displayBatchResults(batchPtr);
+            }
+        }
+        // otherwise, check for batch setup failure
+        else if (batchPtr == NULL) {
+            // show error message, end program
+            printf("\nBatch Setup Error: %s, program aborted.\n", errorMessage);
+        }
+        // otherwise, assume meta data upload failure
+        else {
+            // show error message, end program
+            printf("\nMetadata Upload Error: %s, program aborted.\n", errorMessage);
+        }
+        // clean up batch
+        batchPtr = clearBatch(batchPtr);
+    }
+    // otherwise, check for program run and stream flags, meta data display needs the whole file
+    else if (programRunFlag == True && streamFlag == True && mdDisplayFlag == False) {
+        // open meta data stream, check for success
+        metaDataStreamPtr = openMetaDataStream(configDataPtr->metaDataFileName, STREAM_QUEUE_CAPACITY, errorMessage);
+        if (metaDataStreamPtr != NULL) {
+            // run simulator while the meta data is parsed
+            runSimStream(configDataPtr, metaDataStreamPtr);
+            // check for corrupt meta data found during the run
+            if (getMetaDataStreamResult(metaDataStreamPtr, errorMessage) == False) {
+                // show error message
+                printf("\nMetadata Upload Error: %s, program aborted.\n", errorMessage);
+            }
+            // close meta data stream
+            metaDataStreamPtr = closeMetaDataStream(metaDataStreamPtr);
+        }
+        // otherwise, assume meta data upload failure
+        else {
+            // show error message, end program
+            printf("\nMetadata Upload Error: %s, program aborted.\n", errorMessage);
+        }
+    }
+    // otherwise, check for program run flag
+    else if (programRunFlag == True && (mdDisplayFlag == True || runSimFlag == True))  {
         // upload meta data file, check for success
-        if (getMetaData(configDataPtr->metaDataFileName, &metaDataPtr, errorMessage) == True) {
+        if (getCompiledMetaData(configDataPtr->metaDataFileName, &metaDataPtr, errorMessage, forceCompileFlag) == True) {
             // check meta data display flag
             if (mdDisplayFlag == True) {
                 // display meta data
@@ -121,15 +382,74 @@ int main(int argc, char** argv) {
         }
     }
     // clean up config data as needed
-    configDataPtr = clearConfigData(configDataPtr);
+    for (configIndex = 0; configDataPtrs != NULL && configIndex < configCount; configIndex++) {
+        configDataPtrs[configIndex] = clearConfigData(configDataPtrs[configIndex]);
+    }
+    free(configDataPtrs);
     // clean up metadata as needed
-    metaDataPtr = clearMetaDataList(metaDataPtr);
+    metaDataPtr = clearMetaData(metaDataPtr);
     // show program end
     printf("\nSimulator Program End.\n");
     // return success
     return 0;
 }
 
+/*
+ * name: isConfigFileName
+ * process: checks for a config file name, which ends in .cnf
+ * method input/parameters: arg string
+ * method output/parameters: none
+ * method output/returned: True if the arg ends in .cnf, False otherwise
+ * device input/keyboard: none
+ * device output/monitor: none
+ * dependencies: getStringLength, findSubString
+ */
+Boolean isConfigFileName(char *arg) {
+    // initialize variables
+    int lastFourLetters = 4;
+    int fileStrLen = getStringLength(arg);
+    int fileStrSubLoc = findSubString(arg, ".cnf");
+    // check for .cnf at the end of the arg
+    return fileStrSubLoc != SUBSTRING_NOT_FOUND && fileStrSubLoc == fileStrLen - lastFourLetters;
+}
+
+/*
+ * name: getFlagNumber
+ * process: reads the non negative whole number following a flag, moving the arg index onto it
+ * method input/parameters: arg count, arg strings, index of the flag, pointer to the value
+ * method output/parameters: arg index at the number, value set to the number
+ * method output/returned: True if the flag is followed by a number, False otherwise
+ * device input/keyboard: none
+ * device output/monitor: none
+ * dependencies: getStringLength
+ */
+Boolean getFlagNumber(int argc, char **argv, int *argIndex, int *value) {
+    // initialize variables
+    long number = 0;
+    int charIndex;
+    // check for a following arg
+    if (*argIndex + 1 >= argc) {
+        return False;
+    }
+    // move onto the number
+    (*argIndex)++;
+    // check for an empty or too long number
+    if (getStringLength(argv[*argIndex]) == 0 || getStringLength(argv[*argIndex]) > 9) {
+        return False;
+    }
+    // loop across digits
+    for (charIndex = 0; argv[*argIndex][charIndex] != NULL_CHAR; charIndex++) {
+        // check for non digit
+        if (argv[*argIndex][charIndex] < '0' || argv[*argIndex][charIndex] > '9') {
+            return False;
+        }
+        number = number * 10 + argv[*argIndex][charIndex] - '0';
+    }
+    // set value
+    *value = (int) number;
+    return True;
+}
+
 /*
  * name: showProgramFormat
  * process: displays command line argument requirements for this program
@@ -143,9 +463,30 @@ int main(int argc, char** argv) {
 void showProgramFormat() {
     // print out command line argument instructions
     printf("Program Format:\n");
-    printf("     sim [-dc] [-dm] [-rs] <config file name>\n");
+    printf("     sim [-dc] [-dm] [-rs] [-vt] [-st] [-rc] [-ld] [-mb] [-ms] [-pg <KB>] [-pr <policy>] [-pf <cycles>]\n");
+    printf("         [-pm [csv|json]] [-oh] [-bt <threads>] [-sc] [-sw <config prompt> <value,value,...>]...\n");
+    printf("         <config file name>...\n");
     printf("     -dc [optional] displays configuration data\n");
     printf("     -dm [optional] displays meta data\n");
     printf("     -rs [optional] runs simulator\n");
-    printf("     config file name is required\n");
+    printf("     -vt [optional] runs simulator in virtual time\n");
+    printf("     -st [optional] runs simulator while streaming meta data\n");
+    printf("     -rc [optional] recompiles meta data cache\n");
+    printf("     -ld [optional] drops log lines when the log falls behind\n");
+    printf("     -mb [optional] models a buddy allocator for memory\n");
+    printf("     -ms [optional] models a segregated free-list allocator for memory\n");
+    printf("     -pg [optional] pages memory with the given page size in KB, -mb and -ms are ignored\n");
+    printf("     -pr [optional] sets page replacement to fifo, lru (default) or clock\n");
+    printf("     -pf [optional] sets I/O cycles the hard drive takes per page fault, 1 by default\n");
+    printf("     -pm [optional] displays arrival, first run, completion, cpu, io, ready time and preemptions\n");
+    printf("         of every process at the end of the run, csv or json also writes them next to the log file\n");
+    printf("     -oh [optional] displays histograms of how long clock and device sleeps asked for and took,\n");
+    printf("         thread start and join times and time spent logging, -bt and -sc runs are not recorded\n");
+    printf("     -bt [optional] runs every config file given, and every sweep of them, on a pool of threads\n");
+    printf("         with a log file per run and a table of results, -dm and -st are ignored\n");
+    printf("     -sc [optional] runs a batch in virtual time with every cpu scheduling code and compares\n");
+    printf("         turnaround, waiting and response times, cpu busy time and context switches\n");
+    printf("     -sw [optional] with -bt or -sc, runs each config once per value of the config item with the given prompt,\n");
+    printf("         several sweeps run every combination of their values\n");
+    printf("     config file name is required, several are only taken with -bt or -sc\n");
 }
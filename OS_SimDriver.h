@@ -4,9 +4,13 @@
 #include "datatypes.h"
 #include "StringUtils.h"
 #include "metadataops.h"
+#include "metadatacache.h"
 #include "configops.h"
 #include "simulator.h"
+#include "simbatch.h"
 
+Boolean isConfigFileName(char *arg);
+Boolean getFlagNumber(int argc, char **argv, int *argIndex, int *value);
 void showProgramFormat();
 
 #endif
@@ -1,3 +1,7 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include "StringUtils.h"
 
 const int MAX_STR_LEN = 200;
@@ -263,16 +267,108 @@ char setCharToLowerCase(char testChar) {
     return testChar;
 }
 
+/*
+ * Function Name: openFileBuffer
+ * Algorithm: maps the whole file into memory for sequential reading; if the file can not be mapped
+ *      (eg, a pipe or an empty file) it is read into an allocated buffer in large blocks
+ * Precondition: given file name
+ * Postcondition: returns file buffer with cursor at beginning of file, or null if the file could not be opened
+ * Exceptions: returns null on file access failure
+ * Note: none
+ */
+FileBufferType *openFileBuffer(char *fileName) {
+    // init vars
+        // set block size for files that can not be mapped
+        const long long READ_BLOCK_SIZE = 1 << 20;
+        // init other vars
+        struct stat fileStat;
+        long long capacity = 0;
+        ssize_t bytesRead;
+        FileBufferType *filePtr;
+        int fileDescriptor;
+    // open file, check for failure
+    fileDescriptor = open(fileName, O_RDONLY);
+    if (fileDescriptor < 0) {
+        // return file access failure
+        return NULL;
+    }
+    // create file buffer with cursor at beginning
+    filePtr = (FileBufferType *) calloc(1, sizeof(FileBufferType));
+    // try to map regular, non-empty files
+    if (fstat(fileDescriptor, &fileStat) == 0 && S_ISREG(fileStat.st_mode) && fileStat.st_size > 0) {
+        filePtr->data = mmap(NULL, (size_t) fileStat.st_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+        // check for successful map
+        if (filePtr->data != MAP_FAILED) {
+            // set mapped size
+            filePtr->size = fileStat.st_size;
+            filePtr->mapped = True;
+            // file is read front to back
+            posix_madvise(filePtr->data, (size_t) filePtr->size, POSIX_MADV_SEQUENTIAL);
+        }
+        else {
+            // fall back to reading
+            filePtr->data = NULL;
+        }
+    }
+    // otherwise, read the file in large blocks
+    if (filePtr->mapped == False) {
+        do {
+            // grow buffer as needed
+            if (filePtr->size + READ_BLOCK_SIZE > capacity) {
+                capacity = capacity == 0 ? READ_BLOCK_SIZE : capacity * 2;
+                filePtr->data = (char *) realloc(filePtr->data, (size_t) capacity);
+            }
+            // read next block
+            bytesRead = read(fileDescriptor, filePtr->data + filePtr->size, (size_t) READ_BLOCK_SIZE);
+            if (bytesRead > 0) {
+                filePtr->size += bytesRead;
+            }
+        } while (bytesRead > 0);
+    }
+    // mapping and buffer no longer need the descriptor
+    close(fileDescriptor);
+    // return file buffer
+    return filePtr;
+}
+
+/*
+ * Function Name: closeFileBuffer
+ * Algorithm: unmaps or frees file data, frees file buffer
+ * Precondition: file buffer from openFileBuffer, or null
+ * Postcondition: file memory is released, returns null
+ * Exceptions: none
+ * Note: none
+ */
+FileBufferType *closeFileBuffer(FileBufferType *filePtr) {
+    // check for open file buffer
+    if (filePtr != NULL) {
+        // check for mapped file
+        if (filePtr->mapped == True) {
+            // unmap file data
+            munmap(filePtr->data, (size_t) filePtr->size);
+        }
+        // otherwise, assume read buffer
+        else {
+            // free read buffer
+            free(filePtr->data);
+        }
+        // free file buffer
+        free(filePtr);
+    }
+    // return null
+    return NULL;
+}
+
 /*
  * Function Name: getLineTo
  * Algorithm: finds given text in file, skipping white space if specified, stops searching at given char or length
- * Precondition: file is open with valid file pointer; char buffer has adequate memory for data; stop char and length valid
+ * Precondition: file buffer is open; char buffer has adequate memory for data; stop char and length valid
  * Postcondition: ignores leading white space if specified; captures all printable chars and stores in string buffer
  * Exceptions: returns INCOMPLETE_FILE_ERR if no valid data found;
  *      returns NO_ERR if successful operation
- * Note: none
+ * Note: reads straight from the file buffer, one pass per char without library calls
  */
-int getLineTo(FILE *filePtr, int bufferSize, char stopChar, char *buffer, Boolean omitLeadingWhiteSpace, Boolean stopAtNonPrintable) {
+int getLineTo(FileBufferType *filePtr, int bufferSize, char stopChar, char *buffer, Boolean omitLeadingWhiteSpace, Boolean stopAtNonPrintable) {
     // init vars
         // init char index
         int charIndex = 0;
@@ -280,17 +376,23 @@ int getLineTo(FILE *filePtr, int bufferSize, char stopChar, char *buffer, Boolea
         int statusReturn = NO_ERR;
         // init buffer size available flag to True
         Boolean bufferSizeAvailable = True;
+        // init local copy of file cursor
+        char *data = filePtr->data;
+        long long position = filePtr->position;
+        long long size = filePtr->size;
         // init other vars
         int charAsInt;
+    // start with empty buffer
+    buffer[0] = NULL_CHAR;
     // get the first char
-    charAsInt = fgetc(filePtr);
+    charAsInt = position < size ? (unsigned char) data[position++] : EOF;
     // use a loop to consume leading white space, if flagged
     while (omitLeadingWhiteSpace == True
+        && charAsInt != EOF
         && charAsInt != (int) stopChar
-        && charIndex < bufferSize
         && charAsInt <= (int) SPACE) {
         // get next char (as int)
-        charAsInt = fgetc(filePtr);
+        charAsInt = position < size ? (unsigned char) data[position++] : EOF;
     }
     // end loop
     // capture string
@@ -298,7 +400,10 @@ int getLineTo(FILE *filePtr, int bufferSize, char stopChar, char *buffer, Boolea
     while (charAsInt != (int) stopChar && bufferSizeAvailable == True
         && (stopAtNonPrintable == False || (charAsInt >= ' ' && charAsInt <= '~'))) {
         // check for input failure
-        if (isEndOfFile(filePtr) == True) {
+        if (charAsInt == EOF) {
+            // save cursor, set end of file flag
+            filePtr->position = position;
+            filePtr->endOfFile = True;
             // return incomplete file error
             return INCOMPLETE_FILE_ERR;
         }
@@ -314,7 +419,7 @@ int getLineTo(FILE *filePtr, int bufferSize, char stopChar, char *buffer, Boolea
         // check for not at end of buffer size
         if (charIndex < bufferSize - 1) {
             // get a new char
-            charAsInt = fgetc(filePtr);
+            charAsInt = position < size ? (unsigned char) data[position++] : EOF;
         }
         // otherwise, assume end of buffer size
         else {
@@ -325,24 +430,151 @@ int getLineTo(FILE *filePtr, int bufferSize, char stopChar, char *buffer, Boolea
         }
     }
     // end loop
+    // check for reading past end of file
+    if (charAsInt == EOF) {
+        // set end of file flag
+        filePtr->endOfFile = True;
+    }
+    // save cursor
+    filePtr->position = position;
     // return status data
     return statusReturn;
 }
 
+/*
+ * Function Name: getWordTo
+ * Algorithm: skips leading white space, captures chars up to the next white space (same as scanf "%s")
+ * Precondition: file buffer is open; char buffer has adequate memory for data
+ * Postcondition: word is stored in string buffer, cursor is left on the white space after it
+ * Exceptions: returns INCOMPLETE_FILE_ERR if no word is found, INPUT_BUFFER_OVERRUN_ERR if the word is cut short
+ * Note: none
+ */
+int getWordTo(FileBufferType *filePtr, int bufferSize, char *buffer) {
+    // init vars
+    int charIndex = 0;
+    // skip leading white space
+    while (filePtr->position < filePtr->size && filePtr->data[filePtr->position] <= SPACE) {
+        filePtr->position++;
+    }
+    // capture word
+    while (filePtr->position < filePtr->size && filePtr->data[filePtr->position] > SPACE) {
+        // check for end of buffer size
+        if (charIndex == bufferSize - 1) {
+            // end word, return buffer overrun error
+            buffer[charIndex] = NULL_CHAR;
+            return INPUT_BUFFER_OVERRUN_ERR;
+        }
+        // assign char to buffer, advance cursor
+        buffer[charIndex] = filePtr->data[filePtr->position];
+        charIndex++;
+        filePtr->position++;
+    }
+    // end word
+    buffer[charIndex] = NULL_CHAR;
+    // check for no word found
+    if (charIndex == 0) {
+        // return incomplete file error
+        return INCOMPLETE_FILE_ERR;
+    }
+    // return success
+    return NO_ERR;
+}
+
+/*
+ * Function Name: getIntTo
+ * Algorithm: skips leading white space, converts optional sign and digits to integer (same as scanf "%d")
+ * Precondition: file buffer is open
+ * Postcondition: integer is returned as parameter, cursor is left after the last digit
+ * Exceptions: returns False and leaves value unchanged if no digits are found
+ * Note: none
+ */
+Boolean getIntTo(FileBufferType *filePtr, int *value) {
+    // init vars
+    int result = 0;
+    int sign = 1;
+    Boolean foundDigit = False;
+    // skip leading white space
+    while (filePtr->position < filePtr->size && filePtr->data[filePtr->position] <= SPACE) {
+        filePtr->position++;
+    }
+    // check for sign
+    if (filePtr->position < filePtr->size
+        && (filePtr->data[filePtr->position] == '-' || filePtr->data[filePtr->position] == '+')) {
+        // set sign, advance cursor
+        sign = filePtr->data[filePtr->position] == '-' ? -1 : 1;
+        filePtr->position++;
+    }
+    // loop across digits
+    while (filePtr->position < filePtr->size
+        && filePtr->data[filePtr->position] >= '0' && filePtr->data[filePtr->position] <= '9') {
+        // add digit to result, advance cursor
+        result = result * 10 + (filePtr->data[filePtr->position] - '0');
+        foundDigit = True;
+        filePtr->position++;
+    }
+    // check for digits found
+    if (foundDigit == True) {
+        // assign result
+        *value = sign * result;
+    }
+    // return result of conversion
+    return foundDigit;
+}
+
+/*
+ * Function Name: getDoubleTo
+ * Algorithm: skips leading white space, captures number characters and converts them (same as scanf "%lf")
+ * Precondition: file buffer is open
+ * Postcondition: double is returned as parameter, cursor is left after the number
+ * Exceptions: returns False and leaves value unchanged if no number is found
+ * Note: none
+ */
+Boolean getDoubleTo(FileBufferType *filePtr, double *value) {
+    // init vars
+    const int MAX_NUMBER_LEN = 64;
+    char numberBuffer[MAX_NUMBER_LEN];
+    char *endPtr;
+    int charIndex = 0;
+    char currentChar;
+    // skip leading white space
+    while (filePtr->position < filePtr->size && filePtr->data[filePtr->position] <= SPACE) {
+        filePtr->position++;
+    }
+    // capture number characters
+    while (filePtr->position < filePtr->size && charIndex < MAX_NUMBER_LEN - 1) {
+        currentChar = filePtr->data[filePtr->position];
+        // check for end of number
+        if ((currentChar < '0' || currentChar > '9') && currentChar != PERIOD && currentChar != '-'
+            && currentChar != '+' && currentChar != 'e' && currentChar != 'E') {
+            break;
+        }
+        // assign char to buffer, advance cursor
+        numberBuffer[charIndex] = currentChar;
+        charIndex++;
+        filePtr->position++;
+    }
+    numberBuffer[charIndex] = NULL_CHAR;
+    // convert number, check for failure
+    double result = strtod(numberBuffer, &endPtr);
+    if (endPtr == numberBuffer) {
+        // return conversion failure
+        return False;
+    }
+    // assign result
+    *value = result;
+    // return success
+    return True;
+}
+
 /*
  * Function Name: isEndOfFile
- * Algorithm: reports end of file, using feof
- * Precondition:file is open with valid file pointer
+ * Algorithm: reports end of file, once a read has gone past the end of the file buffer
+ * Precondition: file buffer is open
  * Postcondition: reports end of file
  * Exceptions: none
- * Note: none
+ * Note: same contract as feof
  */
-Boolean isEndOfFile(FILE *filePtr) {
-    // check for feof end of file response
-    if (feof(filePtr) != 0) {
-        // return true
-        return True;
-    }
-    // assume test failed at this point, return false
-    return False;
+Boolean isEndOfFile(FileBufferType *filePtr) {
+    // return end of file flag
+    return filePtr->endOfFile;
 }
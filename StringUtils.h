@@ -17,6 +17,15 @@ extern const int STR_EQ;
 extern const Boolean IGNORE_LEADING_WS;
 extern const Boolean ACCEPT_LEADING_WS;
 
+// whole file held in memory, mapped when possible, read through a cursor
+typedef struct FileBufferType {
+    char *data;
+    long long size;
+    long long position;
+    Boolean endOfFile;
+    Boolean mapped;
+} FileBufferType;
+
 typedef enum {
     NO_ERR,
     INCOMPLETE_FILE_ERR,
@@ -31,7 +40,12 @@ int findSubString(char *testStr, char *searchSubStr);
 void setStrToLowerCase(char *destStr, char *sourceStr);
 char setCharToLowerCase(char testChar);
 void concatenateString(char *destination, char *source);
-int getLineTo(FILE *filePtr, int bufferSize, char stopChar, char *buffer, Boolean omitLeadingWhiteSpace, Boolean stopAtNonPrintable);
-Boolean isEndOfFile(FILE *filePtr);
+FileBufferType *openFileBuffer(char *fileName);
+FileBufferType *closeFileBuffer(FileBufferType *filePtr);
+int getLineTo(FileBufferType *filePtr, int bufferSize, char stopChar, char *buffer, Boolean omitLeadingWhiteSpace, Boolean stopAtNonPrintable);
+int getWordTo(FileBufferType *filePtr, int bufferSize, char *buffer);
+Boolean getIntTo(FileBufferType *filePtr, int *value);
+Boolean getDoubleTo(FileBufferType *filePtr, double *value);
+Boolean isEndOfFile(FileBufferType *filePtr);
 
 #endif
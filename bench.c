@@ -0,0 +1,542 @@
+#include "datatypes.h"
+#include "StringUtils.h"
+#include "metadataops.h"
+#include "configops.h"
+#include "simclock.h"
+#include "simulator.h"
+
+// GLOBAL CONSTANTS
+// a sample has to run at least this long for the clock to time it well
+const long long MIN_SAMPLE_NANOS = 5000000;
+const long long MAX_CALLS_PER_SAMPLE = 1 << 24;
+// the text the line and op parsers run over is the metadata ops repeated up to this size
+const long long PARSE_BUFFER_SIZE = 1 << 20;
+const int MAX_BENCH_SAMPLES = 1000;
+
+// op code layout used before commands and arguments were resolved at parse time
+typedef struct StringOpCodeType {
+    char command[5];
+    char inOutArg[5];
+    char strArg1[15];
+    int intArg2;
+} StringOpCodeType;
+
+/**
+ * Dispatch one op the way runSim did before op codes were interned: a chain of string compares
+ * @param op op code with string fields
+ * @return work done for the op, so the dispatch can not be optimized away
+ */
+long dispatchByString(StringOpCodeType *op) {
+    if (compareString(op->command, "sys") == STR_EQ) {
+        if (compareString(op->strArg1, "start") == STR_EQ) {
+            return 1;
+        } else if (compareString(op->strArg1, "end") == STR_EQ) {
+            return 2;
+        }
+    } else if (compareString(op->command, "app") == STR_EQ) {
+        if (compareString(op->strArg1, "start") == STR_EQ) {
+            return 3;
+        } else if (compareString(op->strArg1, "end") == STR_EQ) {
+            return 4;
+        }
+    } else if (compareString(op->command, "dev") == STR_EQ
+               || compareString(op->command, "cpu") == STR_EQ
+               || compareString(op->command, "mem") == STR_EQ) {
+        if (compareString(op->command, "dev") == STR_EQ) {
+            return op->intArg2;
+        } else if (compareString(op->command, "cpu") == STR_EQ) {
+            if (compareString(op->strArg1, "process") == STR_EQ) {
+                return op->intArg2;
+            }
+        }
+    }
+    return 0;
+}
+
+/**
+ * Dispatch one op on its interned command and argument codes
+ * @param op op code
+ * @return work done for the op, so the dispatch can not be optimized away
+ */
+long dispatchByCode(OpCodeType *op) {
+    switch (op->commandCode) {
+        case CMD_SYS:
+            return op->argCode == ARG_START ? 1 : 2;
+        case CMD_APP:
+            return op->argCode == ARG_START ? 3 : 4;
+        case CMD_DEV:
+            return op->intArg2;
+        case CMD_CPU:
+            return op->argCode == ARG_PROCESS ? op->intArg2 : 0;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * Everything the benchmarks run over, built once before any of them is timed
+ */
+typedef struct BenchContextType {
+    OpProgramType *program;
+    StringOpCodeType *stringOps;
+    char **lines;
+    int lineCount;
+    FileBufferType parseBuffer;
+    long long parseLineCount;
+    char *configFileName;
+    ConfigDataType runConfig;
+} BenchContextType;
+
+typedef long (*BenchFunctionType)(BenchContextType *context);
+
+/**
+ * A benchmark, one call of its function does opsPerCall ops
+ */
+typedef struct BenchmarkType {
+    char *name;
+    BenchFunctionType function;
+    long long opsPerCall;
+} BenchmarkType;
+
+/**
+ * Timing of one benchmark over its samples
+ */
+typedef struct BenchResultType {
+    char *name;
+    long long opsPerSample;
+    double medianNanos;
+    double minNanos;
+    double opsPerSecond;
+} BenchResultType;
+
+// keeps the work of every benchmark observable, so none of it can be optimized away
+volatile long benchSink;
+
+/**
+ * Time getStringLength over every metadata line
+ * @param context bench context
+ * @return total length
+ */
+long benchStringLength(BenchContextType *context) {
+    long total = 0;
+    for (int index = 0; index < context->lineCount; index++) {
+        total += getStringLength(context->lines[index]);
+    }
+    return total;
+}
+
+/**
+ * Time compareString between neighbouring metadata lines
+ * @param context bench context
+ * @return sum of the comparisons
+ */
+long benchCompareString(BenchContextType *context) {
+    long total = 0;
+    for (int index = 0; index < context->lineCount; index++) {
+        total += compareString(context->lines[index], context->lines[(index + 1) % context->lineCount]);
+    }
+    return total;
+}
+
+/**
+ * Time findSubString of a keyword in every metadata line
+ * @param context bench context
+ * @return sum of the found positions
+ */
+long benchFindSubString(BenchContextType *context) {
+    long total = 0;
+    for (int index = 0; index < context->lineCount; index++) {
+        total += findSubString(context->lines[index], "process");
+    }
+    return total;
+}
+
+/**
+ * Time getLineTo over the parse buffer, one line at a time
+ * @param context bench context
+ * @return number of lines read
+ */
+long benchGetLineTo(BenchContextType *context) {
+    char line[MAX_STR_LEN];
+    long total = 0;
+    context->parseBuffer.position = 0;
+    context->parseBuffer.endOfFile = False;
+    while (getLineTo(&context->parseBuffer, MAX_STR_LEN, '\n', line, IGNORE_LEADING_WS, False) == NO_ERR) {
+        total++;
+    }
+    return total;
+}
+
+/**
+ * Time getOpCommand over the parse buffer, from the text of an op to its op code
+ * @param context bench context
+ * @return sum of the op arguments
+ */
+long benchGetOpCommand(BenchContextType *context) {
+    OpCodeType op;
+    long total = 0;
+    context->parseBuffer.position = 0;
+    context->parseBuffer.endOfFile = False;
+    while (context->parseBuffer.position < context->parseBuffer.size) {
+        getOpCommand(&context->parseBuffer, &op);
+        total += op.intArg2;
+    }
+    return total;
+}
+
+/**
+ * Time getConfigData on the config file, from opening the file to the filled config
+ * @param context bench context
+ * @return quantum of the config
+ */
+long benchGetConfigData(BenchContextType *context) {
+    char errorMessage[MAX_STR_LEN];
+    ConfigDataType *configDataPtr;
+    long total = 0;
+    if (getConfigData(context->configFileName, &configDataPtr, errorMessage) == True) {
+        total = configDataPtr->quantumCycles;
+    }
+    clearConfigData(configDataPtr);
+    return total;
+}
+
+/**
+ * Time dispatching every op of the program through a chain of string compares
+ * @param context bench context
+ * @return work done for the ops
+ */
+long benchDispatchString(BenchContextType *context) {
+    long total = 0;
+    for (int index = 0; index < context->program->opCount; index++) {
+        total += dispatchByString(&context->stringOps[index]);
+    }
+    return total;
+}
+
+/**
+ * Time dispatching every op of the program with a switch on its interned codes
+ * @param context bench context
+ * @return work done for the ops
+ */
+long benchDispatchCode(BenchContextType *context) {
+    long total = 0;
+    for (int index = 0; index < context->program->opCount; index++) {
+        total += dispatchByCode(&context->program->ops[index]);
+    }
+    return total;
+}
+
+/**
+ * Time a whole simulator run of the program on the virtual clock, which never sleeps, logging to nowhere
+ * @param context bench context
+ * @return simulated end time
+ */
+long benchRunSim(BenchContextType *context) {
+    SimResultType result;
+    runSimQuiet(&context->runConfig, context->program, &result);
+    return (long) result.endTime;
+}
+
+/**
+ * Time calls of a benchmark function
+ * @param benchmark benchmark
+ * @param context bench context
+ * @param calls number of calls
+ * @return elapsed time in nanoseconds
+ */
+long long timeCalls(BenchmarkType *benchmark, BenchContextType *context, long long calls) {
+    long checksum = 0;
+    long long startTime = getMonotonicNanoTime();
+    for (long long call = 0; call < calls; call++) {
+        checksum += benchmark->function(context);
+    }
+    long long elapsed = getMonotonicNanoTime() - startTime;
+    benchSink += checksum;
+    return elapsed;
+}
+
+/**
+ * Order two sample times for qsort
+ * @param one first time
+ * @param other second time
+ * @return negative, zero or positive as one is below, equal to or above other
+ */
+int compareSamples(const void *one, const void *other) {
+    double oneTime = *(const double *) one;
+    double otherTime = *(const double *) other;
+    return (oneTime > otherTime) - (oneTime < otherTime);
+}
+
+/**
+ * Run a benchmark: find how many calls make a sample long enough to time, run the warmup samples,
+ * then time every sample
+ * @param benchmark benchmark
+ * @param context bench context
+ * @param warmups samples run before timing
+ * @param samples samples timed
+ * @return median and fastest time per op over the samples
+ */
+BenchResultType runBenchmark(BenchmarkType *benchmark, BenchContextType *context, int warmups, int samples) {
+    BenchResultType result = {benchmark->name, 0, 0.0, 0.0, 0.0};
+    double sampleNanos[MAX_BENCH_SAMPLES];
+    long long calls = 1;
+
+    while (calls < MAX_CALLS_PER_SAMPLE && timeCalls(benchmark, context, calls) < MIN_SAMPLE_NANOS) {
+        calls *= 2;
+    }
+    for (int sample = 0; sample < warmups; sample++) {
+        timeCalls(benchmark, context, calls);
+    }
+    result.opsPerSample = calls * benchmark->opsPerCall;
+    for (int sample = 0; sample < samples; sample++) {
+        sampleNanos[sample] = (double) timeCalls(benchmark, context, calls) / result.opsPerSample;
+    }
+    qsort(sampleNanos, samples, sizeof(double), compareSamples);
+    result.medianNanos = samples % 2 == 1 ? sampleNanos[samples / 2]
+                                          : (sampleNanos[samples / 2 - 1] + sampleNanos[samples / 2]) / 2.0;
+    result.minNanos = sampleNanos[0];
+    result.opsPerSecond = result.medianNanos > 0.0 ? 1000000000.0 / result.medianNanos : 0.0;
+    return result;
+}
+
+/**
+ * Find the median time per op of a benchmark in a baseline written by bench -m
+ * @param baselineFile baseline file, or NULL
+ * @param name benchmark name
+ * @return median nanoseconds per op, negative if the baseline has no such benchmark
+ */
+double findBaseline(FILE *baselineFile, char *name) {
+    char line[MAX_STR_LEN];
+    char lineName[MAX_STR_LEN];
+    long long opsPerSample;
+    double medianNanos;
+
+    if (baselineFile == NULL) {
+        return -1.0;
+    }
+    rewind(baselineFile);
+    while (fgets(line, MAX_STR_LEN, baselineFile) != NULL) {
+        if (sscanf(line, "%127[^,],%lld,%lf", lineName, &opsPerSample, &medianNanos) == 3
+            && compareString(lineName, name) == STR_EQ) {
+            return medianNanos;
+        }
+    }
+    return -1.0;
+}
+
+/**
+ * Build the bench context: the program, its ops in string form, its text lines and the parse buffer
+ * @param context bench context to fill
+ * @param fileName metadata file
+ * @param configFileName config file
+ * @param errorMessage error message on failure
+ * @return False if the metadata or the config does not load
+ */
+Boolean createBenchContext(BenchContextType *context, char *fileName, char *configFileName, char *errorMessage) {
+    char line[MAX_STR_LEN];
+    ConfigDataType *configDataPtr;
+
+    if (getMetaData(fileName, &context->program, errorMessage) == False) {
+        return False;
+    }
+    if (getConfigData(configFileName, &configDataPtr, errorMessage) == False) {
+        return False;
+    }
+    context->configFileName = configFileName;
+    context->runConfig = *configDataPtr;
+    context->runConfig.clockModeCode = CLOCK_VIRTUAL_CODE;
+    context->runConfig.logToCode = LOGTO_FILE_CODE;
+    copyString(context->runConfig.logToFileName, "/dev/null");
+    clearConfigData(configDataPtr);
+
+    // rebuild the string form of every op for the old dispatch
+    context->stringOps = malloc(context->program->opCount * sizeof(StringOpCodeType));
+    for (int index = 0; index < context->program->opCount; index++) {
+        OpCodeType *op = &context->program->ops[index];
+        copyString(context->stringOps[index].command, getCommandName(op->commandCode));
+        // copyString leaves the destination alone for an empty source
+        context->stringOps[index].inOutArg[0] = NULL_CHAR;
+        copyString(context->stringOps[index].inOutArg, getInOutName(op->inOutCode));
+        copyString(context->stringOps[index].strArg1, getArgName(op->argCode));
+        context->stringOps[index].intArg2 = op->intArg2;
+    }
+
+    // keep the op lines, between the start and end descriptors
+    FileBufferType *filePtr = openFileBuffer(fileName);
+    context->lines = malloc(context->program->opCount * sizeof(char *));
+    getLineTo(filePtr, MAX_STR_LEN, '\n', line, IGNORE_LEADING_WS, False);
+    while (context->lineCount < context->program->opCount
+           && getLineTo(filePtr, MAX_STR_LEN, '\n', line, IGNORE_LEADING_WS, False) == NO_ERR) {
+        context->lines[context->lineCount] = malloc(getStringLength(line) + 1);
+        copyString(context->lines[context->lineCount++], line);
+    }
+    closeFileBuffer(filePtr);
+
+    // repeat the op lines into a buffer big enough that parsing it is not all cache hits
+    long long textSize = 0;
+    for (int index = 0; index < context->lineCount; index++) {
+        textSize += getStringLength(context->lines[index]) + 1;
+    }
+    long long repeatCount = PARSE_BUFFER_SIZE / (textSize > 0 ? textSize : 1) + 1;
+    context->parseBuffer.data = malloc(textSize * repeatCount);
+    for (long long repeat = 0; repeat < repeatCount; repeat++) {
+        for (int index = 0; index < context->lineCount; index++) {
+            int length = getStringLength(context->lines[index]);
+            for (int charIndex = 0; charIndex < length; charIndex++) {
+                context->parseBuffer.data[context->parseBuffer.size++] = context->lines[index][charIndex];
+            }
+            context->parseBuffer.data[context->parseBuffer.size++] = '\n';
+        }
+    }
+    context->parseLineCount = repeatCount * context->lineCount;
+    return True;
+}
+
+/**
+ * Free the bench context
+ * @param context bench context
+ */
+void clearBenchContext(BenchContextType *context) {
+    for (int index = 0; index < context->lineCount; index++) {
+        free(context->lines[index]);
+    }
+    free(context->lines);
+    free(context->parseBuffer.data);
+    free(context->stringOps);
+    clearMetaData(context->program);
+}
+
+/**
+ * Display the command line format of the benchmarks
+ */
+void showBenchFormat() {
+    printf("Program Format:\n");
+    printf("     bench [-i <samples>] [-w <warmups>] [-f <name>] [-m] [-b <baseline>] [-t <percent>]\n");
+    printf("         [metadata file] [config file]\n");
+    printf("     -i timed samples per benchmark, 10 by default\n");
+    printf("     -w untimed warmup samples per benchmark, 2 by default\n");
+    printf("     -f only runs benchmarks whose name contains the given text\n");
+    printf("     -m prints comma separated results, which can be saved as a baseline\n");
+    printf("     -b compares the median time per op with a baseline saved from -m, exits with 1 on a regression\n");
+    printf("     -t percent slower than the baseline that counts as a regression, 10 by default\n");
+    printf("     the metadata file defaults to metadata_0.mdf, the config file to config0.cnf\n");
+}
+
+/**
+ * Run the microbenchmarks of the string utilities, the parsers and op dispatch.
+ * Every benchmark reports its median and fastest time per op over the timed samples.
+ */
+int main(int argc, char **argv) {
+    char *fileName = "metadata_0.mdf";
+    char *configFileName = "config0.cnf";
+    char *filter = NULL;
+    char *baselineName = NULL;
+    FILE *baselineFile = NULL;
+    Boolean machineFlag = False;
+    Boolean argsValid = True;
+    Boolean regressed = False;
+    int samples = 10;
+    int warmups = 2;
+    int threshold = 10;
+    int fileArgCount = 0;
+    char errorMessage[MAX_STR_LEN];
+    BenchContextType context = {0};
+
+    for (int argIndex = 1; argsValid == True && argIndex < argc; argIndex++) {
+        Boolean hasValue = argIndex + 1 < argc;
+        if (compareString(argv[argIndex], "-m") == STR_EQ) {
+            machineFlag = True;
+        } else if (compareString(argv[argIndex], "-i") == STR_EQ && hasValue == True) {
+            samples = atoi(argv[++argIndex]);
+            argsValid = samples >= 1 && samples <= MAX_BENCH_SAMPLES;
+        } else if (compareString(argv[argIndex], "-w") == STR_EQ && hasValue == True) {
+            warmups = atoi(argv[++argIndex]);
+            argsValid = warmups >= 0;
+        } else if (compareString(argv[argIndex], "-t") == STR_EQ && hasValue == True) {
+            threshold = atoi(argv[++argIndex]);
+            argsValid = threshold >= 0;
+        } else if (compareString(argv[argIndex], "-f") == STR_EQ && hasValue == True) {
+            filter = argv[++argIndex];
+        } else if (compareString(argv[argIndex], "-b") == STR_EQ && hasValue == True) {
+            baselineName = argv[++argIndex];
+        } else if (argv[argIndex][0] != '-' && fileArgCount == 0) {
+            fileName = argv[argIndex];
+            fileArgCount++;
+        } else if (argv[argIndex][0] != '-' && fileArgCount == 1) {
+            configFileName = argv[argIndex];
+            fileArgCount++;
+        } else {
+            argsValid = False;
+        }
+    }
+    if (argsValid == False) {
+        showBenchFormat();
+        return 1;
+    }
+    if (baselineName != NULL && (baselineFile = fopen(baselineName, "r")) == NULL) {
+        printf("Baseline file %s can not be read\n", baselineName);
+        return 1;
+    }
+    if (createBenchContext(&context, fileName, configFileName, errorMessage) == False) {
+        printf("Benchmark Setup Error: %s\n", errorMessage);
+        return 1;
+    }
+
+    BenchmarkType benchmarks[] = {
+        {"getStringLength", benchStringLength, context.lineCount},
+        {"compareString", benchCompareString, context.lineCount},
+        {"findSubString", benchFindSubString, context.lineCount},
+        {"getLineTo", benchGetLineTo, context.parseLineCount},
+        {"getOpCommand", benchGetOpCommand, context.parseLineCount},
+        {"getConfigData", benchGetConfigData, 1},
+        {"dispatchString", benchDispatchString, context.program->opCount},
+        {"dispatchCode", benchDispatchCode, context.program->opCount},
+        {"runSim", benchRunSim, context.program->opCount}
+    };
+    int benchmarkCount = (int) (sizeof(benchmarks) / sizeof(benchmarks[0]));
+
+    if (machineFlag == True) {
+        printf("name,ops_per_sample,median_ns_per_op,min_ns_per_op,ops_per_sec%s\n",
+               baselineFile != NULL ? ",baseline_ns_per_op,change_percent" : "");
+    } else {
+        printf("Benchmarks: %s, %d ops, %s, %d samples after %d warmups\n\n", fileName, context.program->opCount,
+               configFileName, samples, warmups);
+        printf("%-16s %14s %14s %14s %16s%s\n", "benchmark", "ops/sample", "median ns/op", "min ns/op", "ops/s",
+               baselineFile != NULL ? "       baseline    change" : "");
+    }
+    for (int index = 0; index < benchmarkCount; index++) {
+        if (filter != NULL && findSubString(benchmarks[index].name, filter) == SUBSTRING_NOT_FOUND) {
+            continue;
+        }
+        BenchResultType result = runBenchmark(&benchmarks[index], &context, warmups, samples);
+        double baselineNanos = findBaseline(baselineFile, result.name);
+        double change = baselineNanos > 0.0 ? 100.0 * (result.medianNanos - baselineNanos) / baselineNanos : 0.0;
+        Boolean slower = baselineNanos > 0.0 && change > threshold;
+        if (slower == True) {
+            regressed = True;
+        }
+        if (machineFlag == True) {
+            printf("%s,%lld,%.3f,%.3f,%.1f", result.name, result.opsPerSample, result.medianNanos, result.minNanos,
+                   result.opsPerSecond);
+            if (baselineFile != NULL) {
+                printf(",%.3f,%.1f", baselineNanos, change);
+            }
+            printf("\n");
+        } else {
+            printf("%-16s %14lld %14.2f %14.2f %16.0f", result.name, result.opsPerSample, result.medianNanos,
+                   result.minNanos, result.opsPerSecond);
+            if (baselineFile != NULL && baselineNanos > 0.0) {
+                printf(" %14.2f %+8.1f%%%s", baselineNanos, change, slower == True ? " REGRESSION" : "");
+            } else if (baselineFile != NULL) {
+                printf(" %14s", "none");
+            }
+            printf("\n");
+        }
+    }
+
+    if (baselineFile != NULL) {
+        fclose(baselineFile);
+    }
+    clearBenchContext(&context);
+    return regressed == True ? 1 : 0;
+}
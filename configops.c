@@ -42,16 +42,32 @@ void displayConfigData(ConfigDataType *configData) {
     printf("Memory available       : %d\n", configData->memAvailable);
     printf("Process cycle rate     : %d\n", configData->procCycleRate);
     printf("I/O cycle rate         : %d\n", configData->ioCycleRate);
+    printf("CPU cores              : %d\n", configData->cpuCores);
+    printf("Migration penalty      : %d\n", configData->migrationCycles);
     configCodeToString(configData->logToCode, displayString);
     printf("Log to selection       : %s\n", displayString);
-    printf("Log file name          : %s\n\n", configData->logToFileName);
+    printf("Log file name          : %s\n", configData->logToFileName);
+    configCodeToString(configData->logFullCode, displayString);
+    printf("Log when full          : %s\n", displayString);
+    configCodeToString(configData->clockModeCode, displayString);
+    printf("Simulation clock       : %s\n", displayString);
+    configCodeToString(configData->memAllocCode, displayString);
+    printf("Memory allocator       : %s\n", displayString);
+    printf("Page size (KB)         : %d\n", configData->pageSize);
+    configCodeToString(configData->pageReplaceCode, displayString);
+    printf("Page replacement       : %s\n", displayString);
+    printf("Page fault (cycles)    : %d\n", configData->pageFaultCycles);
+    configCodeToString(configData->metricsCode, displayString);
+    printf("Process metrics        : %s\n", displayString);
+    printf("Overhead histograms    : %s\n\n", configData->recordOverhead == True ? "On" : "Off");
 }
 
 /*
  * Function Name: getConfigData
  * Algorithm: opens file, acquires configuration data, returns pointer to data structure
  * Precondition: for correct operation, file is available, is formatted correctly, and has all configuration lines and
- *      data although the configuration lines are not required to be in a specific order.
+ *      data although the configuration lines are not required to be in a specific order. The CPU Cores and
+ *      Migration Penalty (cycles) lines are optional.
  *  PostCondition: in correct operation, returns pointer to correct configuration data structure
  *  Exceptions: correctly and appropriately (without program failure) responds to and reports file access failure,
  *      incorrectly formatted lead or end descriptors, incorrectly formatted prompt, data out of range, and
@@ -62,12 +78,10 @@ Boolean getConfigData(char *fileName, ConfigDataType **configData, char *endStat
     // initialize variables
         // set constant number of data lines
         const int NUM_DATA_LINES = 9;
-        // set read only constant
-        const char READ_ONLY_FLAG[] = "r";
         // create pointer for data input
         ConfigDataType *tempData;
         // declare other variables
-        FILE *fileAccessPtr;
+        FileBufferType *fileAccessPtr;
         char dataBuffer[MAX_STR_LEN];
         int intData, dataLineCode, lineCtr = 0;
         double doubleData;
@@ -76,8 +90,8 @@ Boolean getConfigData(char *fileName, ConfigDataType **configData, char *endStat
     copyString(endStateMsg, "Configuration file upload successful.");
     // initialize config data pointer in case of return error
     *configData = NULL;
-    // open file
-    fileAccessPtr = fopen(fileName, READ_ONLY_FLAG);
+    // open file buffer
+    fileAccessPtr = openFileBuffer(fileName);
     // check for file open failure
     if (fileAccessPtr == NULL) {
         // set end state message to config file access error
@@ -89,7 +103,7 @@ Boolean getConfigData(char *fileName, ConfigDataType **configData, char *endStat
     if (getLineTo(fileAccessPtr, MAX_STR_LEN, COLON, dataBuffer, IGNORE_LEADING_WS, dontStopAtNonPrintable) != NO_ERR
         || compareString(dataBuffer, "Start Simulator Configuration File") != STR_EQ) {
         // close file access
-        fclose(fileAccessPtr);
+        fileAccessPtr = closeFileBuffer(fileAccessPtr);
         // set end state message to corrupt leader line error
         copyString(endStateMsg, "Corrupt configuration leader line error");
         // return corrupt file data
@@ -97,14 +111,31 @@ Boolean getConfigData(char *fileName, ConfigDataType **configData, char *endStat
     }
     // create temp pointer to config data structure
     tempData = (ConfigDataType *) malloc(sizeof(ConfigDataType));
-    // loop to end of config data items
-    while (lineCtr < NUM_DATA_LINES) {
+    // default to running the simulation in real time
+    tempData->clockModeCode = CLOCK_REAL_CODE;
+    // default to waiting for the log writer rather than losing log lines
+    tempData->logFullCode = LOG_FULL_BLOCK_CODE;
+    // default to only checking memory ops, without modelling a physical allocator
+    tempData->memAllocCode = MEM_ALLOC_NONE_CODE;
+    // default to no paging, with LRU replacement and one I/O cycle per page fault once it is on
+    tempData->pageSize = 0;
+    tempData->pageReplaceCode = PAGE_REPLACE_LRU_CODE;
+    tempData->pageFaultCycles = 1;
+    // default to one core, which has nothing to migrate between
+    tempData->cpuCores = 1;
+    tempData->migrationCycles = 0;
+    // default to no process metrics beyond the run summary
+    tempData->metricsCode = METRICS_NONE_CODE;
+    // default to not timing the simulator's own sleeps, threads and logging
+    tempData->recordOverhead = False;
+    // loop to end of config data items, taking optional items as they come
+    while (lineCtr < NUM_DATA_LINES || isOptionalLineNext(fileAccessPtr) == True) {
         // get line leader, check for failure
         if (getLineTo(fileAccessPtr, MAX_STR_LEN, COLON, dataBuffer, IGNORE_LEADING_WS, dontStopAtNonPrintable) != NO_ERR) {
             // free temp struct memory
             free(tempData);
             // close file access
-            fclose(fileAccessPtr);
+            fileAccessPtr = closeFileBuffer(fileAccessPtr);
             // set end state message to line capture failure
             copyString(endStateMsg, "Configuration start line capture error");
             // return incomplete file error
@@ -118,7 +149,7 @@ Boolean getConfigData(char *fileName, ConfigDataType **configData, char *endStat
                 // check for version number
                 if (dataLineCode == CFG_VERSION_CODE) {
                     // get version number
-                    fscanf(fileAccessPtr, "%lf", &doubleData);
+                    getDoubleTo(fileAccessPtr, &doubleData);
                 }
                 // otherwise, check for metaData or logTo file names or CPU Scheduling names
                 else if (dataLineCode == CFG_MD_FILE_NAME_CODE
@@ -126,52 +157,24 @@ Boolean getConfigData(char *fileName, ConfigDataType **configData, char *endStat
                     || dataLineCode == CFG_CPU_SCHED_CODE
                     || dataLineCode == CFG_LOG_TO_CODE) {
                     // get string input
-                    fscanf(fileAccessPtr, "%s", dataBuffer);
+                    getWordTo(fileAccessPtr, MAX_STR_LEN, dataBuffer);
                 }
                 // otherwise, assume integer data
                 else {
                     // get integer input
-                    fscanf(fileAccessPtr, "%d", &intData);
+                    getIntTo(fileAccessPtr, &intData);
                 }
             // check for data value in range
             if (valueInRange(dataLineCode, intData, doubleData, dataBuffer) == True) {
                 // assign to data pointer depending on config item
-                switch(dataLineCode) {
-                    case CFG_VERSION_CODE:
-                        tempData->version = doubleData;
-                        break;
-                    case CFG_MD_FILE_NAME_CODE:
-                        copyString(tempData->metaDataFileName, dataBuffer);
-                        break;
-                    case CFG_CPU_SCHED_CODE:
-                        tempData->cpuSchedCode = getCpuSchedCode(dataBuffer);
-                        break;
-                    case CFG_QUANT_CYCLES_CODE:
-                        tempData->quantumCycles = intData;
-                        break;
-                    case CFG_MEM_AVAILABLE_CODE:
-                        tempData->memAvailable = intData;
-                        break;
-                    case CFG_PROC_CYCLES_CODE:
-                        tempData->procCycleRate = intData;
-                        break;
-                    case CFG_IO_CYCLES_CODE:
-                        tempData->ioCycleRate = intData;
-                        break;
-                    case CFG_LOG_TO_CODE:
-                        tempData->logToCode = getLogToCode(dataBuffer);
-                        break;
-                    case CFG_LOG_FILE_NAME_CODE:
-                        copyString(tempData->logToFileName, dataBuffer);
-                        break;
-                }
+                assignConfigValue(tempData, dataLineCode, intData, doubleData, dataBuffer);
             }
             // otherwise, assume data value not in range
             else {
                 // free temp struct memory
                 free(tempData);
                 // close file access
-                fclose(fileAccessPtr);
+                fileAccessPtr = closeFileBuffer(fileAccessPtr);
                 // set end state message to config data out of range
                 copyString(endStateMsg, "Configuration item out of range");
                 // return data out of range
@@ -183,14 +186,16 @@ Boolean getConfigData(char *fileName, ConfigDataType **configData, char *endStat
             // free temp struct memory
             free(tempData);
             // close file access
-            fclose(fileAccessPtr);
+            fileAccessPtr = closeFileBuffer(fileAccessPtr);
             // set end state message to configuration corrupt prompt error
             copyString(endStateMsg, "Corrupted configuration prompt");
             // return corrupt config file code
             return False;
         }
-        // increment line counter
-        lineCtr++;
+        // increment line counter, optional lines do not count
+        if (isOptionalDataLine(dataLineCode) == False) {
+            lineCtr++;
+        }
     // end master loop
     }
 
@@ -200,7 +205,7 @@ Boolean getConfigData(char *fileName, ConfigDataType **configData, char *endStat
         // free temp struct memory
         free(tempData);
         // close file access
-        fclose(fileAccessPtr);
+        fileAccessPtr = closeFileBuffer(fileAccessPtr);
         // set end state message to corrupt config end line
         copyString(endStateMsg, "Configuration end line capture error");
         // return corrupt file data
@@ -209,11 +214,114 @@ Boolean getConfigData(char *fileName, ConfigDataType **configData, char *endStat
     // assign temporary pointer to parameter return pointer
     *configData = tempData;
     // close file access
-    fclose(fileAccessPtr);
+    fileAccessPtr = closeFileBuffer(fileAccessPtr);
     // return no error code
     return True;
 }
 
+/*
+ * Function Name: assignConfigValue
+ * Algorithm: stores a data value in the config item named by the line code
+ * Precondition: the value fitting the line code has passed valueInRange
+ * Postcondition: the config item is set, the other values are ignored
+ * Exceptions: unknown line codes leave the config data unchanged
+ * Notes: none
+ */
+void assignConfigValue(ConfigDataType *configData, int lineCode, int intVal, double doubleVal, char *stringVal) {
+    // assign to data pointer depending on config item
+    switch(lineCode) {
+        case CFG_VERSION_CODE:
+            configData->version = doubleVal;
+            break;
+        case CFG_MD_FILE_NAME_CODE:
+            copyString(configData->metaDataFileName, stringVal);
+            break;
+        case CFG_CPU_SCHED_CODE:
+            configData->cpuSchedCode = getCpuSchedCode(stringVal);
+            break;
+        case CFG_QUANT_CYCLES_CODE:
+            configData->quantumCycles = intVal;
+            break;
+        case CFG_MEM_AVAILABLE_CODE:
+            configData->memAvailable = intVal;
+            break;
+        case CFG_PROC_CYCLES_CODE:
+            configData->procCycleRate = intVal;
+            break;
+        case CFG_IO_CYCLES_CODE:
+            configData->ioCycleRate = intVal;
+            break;
+        case CFG_LOG_TO_CODE:
+            configData->logToCode = getLogToCode(stringVal);
+            break;
+        case CFG_LOG_FILE_NAME_CODE:
+            copyString(configData->logToFileName, stringVal);
+            break;
+        case CFG_CPU_CORES_CODE:
+            configData->cpuCores = intVal;
+            break;
+        case CFG_MIGRATION_CYCLES_CODE:
+            configData->migrationCycles = intVal;
+            break;
+    }
+}
+
+/*
+ * Function Name: setConfigValue
+ * Algorithm: finds the config item from its prompt, converts the value string to the item's type, checks its
+ *      range and stores it
+ * Precondition: prompt and valueStr are C-style strings, prompt as written before the colon of a config line
+ *      (eg, "Quantum Time (cycles)")
+ * Postcondition: returns True with the config item set, False with the config data unchanged
+ * Exceptions: unknown prompts, values that are not wholly a number, values out of range and file names too long
+ *      for the config data return False
+ * Notes: lets a config item be overridden without a config file, as the batch runner's sweeps do
+ */
+Boolean setConfigValue(ConfigDataType *configData, char *prompt, char *valueStr) {
+    // initialize variables
+    int lineCode = getDataLineCode(prompt);
+    int intData = 0;
+    long longData;
+    double doubleData = 0.0;
+    char *endPtr = valueStr;
+    // check for prompt not found or empty value
+    if (lineCode == CFG_CORRUPT_PROMPT_ERR || getStringLength(valueStr) == 0) {
+        return False;
+    }
+    // check for version number
+    if (lineCode == CFG_VERSION_CODE) {
+        // get version number
+        doubleData = strtod(valueStr, &endPtr);
+    }
+    // otherwise, check for metaData or logTo file names, which must fit the config data
+    else if (lineCode == CFG_MD_FILE_NAME_CODE || lineCode == CFG_LOG_FILE_NAME_CODE) {
+        // check for file name too long
+        if (getStringLength(valueStr) >= (int) sizeof(configData->metaDataFileName)) {
+            return False;
+        }
+        // take the whole string
+        endPtr = valueStr + getStringLength(valueStr);
+    }
+    // otherwise, check for CPU Scheduling or Log To names
+    else if (lineCode == CFG_CPU_SCHED_CODE || lineCode == CFG_LOG_TO_CODE) {
+        // take the whole string
+        endPtr = valueStr + getStringLength(valueStr);
+    }
+    // otherwise, assume integer data
+    else {
+        // get integer input, numbers too big for an int are out of range anyway
+        longData = strtol(valueStr, &endPtr, 10);
+        intData = longData < INT_MIN || longData > INT_MAX ? -1 : (int) longData;
+    }
+    // check for trailing characters after a number, or data value out of range
+    if (*endPtr != NULL_CHAR || valueInRange(lineCode, intData, doubleData, valueStr) == False) {
+        return False;
+    }
+    // assign to data pointer depending on config item
+    assignConfigValue(configData, lineCode, intData, doubleData, valueStr);
+    return True;
+}
+
 /*
  * Function Name: configCodeToString
  * Algorithm: utility function: to support display of CPU scheduling or Log To code strings
@@ -225,8 +333,10 @@ Boolean getConfigData(char *fileName, ConfigDataType **configData, char *endStat
  */
 void configCodeToString(int code, char *outString) {
     // return appropriate code depending on prompt string provided
-    char displayStrings[8][10] = {
-            "SJF-N", "SRTF-P", "FCFS-P", "RR-P", "FCFS-N", "Monitor", "File", "Both"
+    char displayStrings[23][11] = {
+            "SJF-N", "SRTF-P", "FCFS-P", "RR-P", "FCFS-N", "Monitor", "File", "Both", "Real", "Virtual",
+            "Block", "Drop", "Trace", "None", "Buddy", "Segregated", "FIFO", "LRU", "CLOCK",
+            "None", "Display", "CSV", "JSON"
     };
     copyString(outString, displayStrings[code]);
 }
@@ -269,9 +379,52 @@ int getDataLineCode(char *dataBuffer) {
     if (compareString(dataBuffer, "Log File Path") == STR_EQ) {
         return CFG_LOG_FILE_NAME_CODE;
     }
+    if (compareString(dataBuffer, "CPU Cores") == STR_EQ) {
+        return CFG_CPU_CORES_CODE;
+    }
+    if (compareString(dataBuffer, "Migration Penalty (cycles)") == STR_EQ) {
+        return CFG_MIGRATION_CYCLES_CODE;
+    }
     return CFG_CORRUPT_PROMPT_ERR;
 }
 
+/*
+ * Function Name: isOptionalDataLine
+ * Algorithm: tests a data line code for one of the lines a config file may leave out
+ * Precondition: lineCode is a data line code from getDataLineCode
+ * Postcondition: returns True for an optional line, False otherwise
+ * Exceptions: none
+ * Notes: none
+ */
+Boolean isOptionalDataLine(int lineCode) {
+    return lineCode == CFG_CPU_CORES_CODE || lineCode == CFG_MIGRATION_CYCLES_CODE;
+}
+
+/*
+ * Function Name: isOptionalLineNext
+ * Algorithm: reads the leader of the next line and puts the file cursor back, so the line is read again
+ * Precondition: file buffer is open, positioned at the start of a line
+ * Postcondition: returns True if the next line is an optional data line, False otherwise
+ * Exceptions: the end line or the end of the file return False
+ * Notes: none
+ */
+Boolean isOptionalLineNext(FileBufferType *filePtr) {
+    // initialize variables
+    char dataBuffer[MAX_STR_LEN];
+    long long linePosition = filePtr->position;
+    Boolean lineEndOfFile = filePtr->endOfFile;
+    Boolean stopAtNonPrintable = True;
+    Boolean result = False;
+    // get line leader, stopping at the end of the line when it has no colon
+    if (getLineTo(filePtr, MAX_STR_LEN, COLON, dataBuffer, IGNORE_LEADING_WS, stopAtNonPrintable) == NO_ERR) {
+        result = isOptionalDataLine(getDataLineCode(dataBuffer));
+    }
+    // put the cursor back at the start of the line
+    filePtr->position = linePosition;
+    filePtr->endOfFile = lineEndOfFile;
+    return result;
+}
+
 /*
  * Function Name: valueInRange
  * Algorithm: tests onf of three values (int, double, string) for being in specified range, depending on data code
@@ -346,6 +499,22 @@ Boolean valueInRange(int lineCode, int intVal, double doubleVal, char *stringVal
                 result = False;
             }
             break;
+        // check for cpu cores
+        case CFG_CPU_CORES_CODE:
+            // check for cpu core limits exceeded
+            if (intVal < 1 || intVal > 64) {
+                // set Boolean result to false
+                result = False;
+            }
+            break;
+        // check for migration penalty
+        case CFG_MIGRATION_CYCLES_CODE:
+            // check for migration penalty limits exceeded
+            if (intVal < 0 || intVal > 100) {
+                // set Boolean result to false
+                result = False;
+            }
+            break;
         // check for log to operations
         case CFG_LOG_TO_CODE:
             // create temp string and set it to lower case
@@ -355,7 +524,8 @@ Boolean valueInRange(int lineCode, int intVal, double doubleVal, char *stringVal
             // check for not finding one of the log to strings
             if (compareString(tempStr, "both") != STR_EQ
                 && compareString(tempStr, "monitor") != STR_EQ
-                && compareString(tempStr, "file")) {
+                && compareString(tempStr, "file")
+                && compareString(tempStr, "trace") != STR_EQ) {
                 // set Boolean result to false
                 result = False;
             }
@@ -412,7 +582,7 @@ ConfigDataCodes getCpuSchedCode(char *codeStr) {
 
 /*
  * Function Name: getLogToCode
- * Algorithm: converts string data (eg, File, Monitor) to constant code number to be stored as integer
+ * Algorithm: converts string data (eg, File, Monitor, Trace) to constant code number to be stored as integer
  * Precondition: codeStr is a C-Style string with one of the specified log to operations
  * Postcondition: returns code representing log to actions
  * Exceptions: defaults to monitor code
@@ -437,6 +607,11 @@ ConfigDataCodes getLogToCode(char *logToStr) {
         // set return value to file code
         returnVal = LOGTO_FILE_CODE;
     }
+    // check for TRACE
+    if (compareString(tempStr, "trace") == STR_EQ) {
+        // set return value to binary trace code
+        returnVal = LOGTO_TRACE_CODE;
+    }
     // free temp string memory
     free(tempStr);
     // return found code
@@ -1,6 +1,7 @@
 #ifndef CONFIGOPS_H
 #define CONFIGOPS_H
 
+#include <limits.h>
 #include "datatypes.h"
 #include "StringUtils.h"
 
@@ -20,7 +21,9 @@ typedef enum {
     CFG_PROC_CYCLES_CODE,
     CFG_IO_CYCLES_CODE,
     CFG_LOG_TO_CODE,
-    CFG_LOG_FILE_NAME_CODE
+    CFG_LOG_FILE_NAME_CODE,
+    CFG_CPU_CORES_CODE,
+    CFG_MIGRATION_CYCLES_CODE
 } ConfigCodeMessages;
 
 typedef enum {
@@ -31,15 +34,34 @@ typedef enum {
     CPU_SCHED_FCFS_N_CODE,
     LOGTO_MONITOR_CODE,
     LOGTO_FILE_CODE,
-    LOGTO_BOTH_CODE
+    LOGTO_BOTH_CODE,
+    CLOCK_REAL_CODE,
+    CLOCK_VIRTUAL_CODE,
+    LOG_FULL_BLOCK_CODE,
+    LOG_FULL_DROP_CODE,
+    LOGTO_TRACE_CODE,
+    MEM_ALLOC_NONE_CODE,
+    MEM_ALLOC_BUDDY_CODE,
+    MEM_ALLOC_SEGREGATED_CODE,
+    PAGE_REPLACE_FIFO_CODE,
+    PAGE_REPLACE_LRU_CODE,
+    PAGE_REPLACE_CLOCK_CODE,
+    METRICS_NONE_CODE,
+    METRICS_DISPLAY_CODE,
+    METRICS_CSV_CODE,
+    METRICS_JSON_CODE
 } ConfigDataCodes;
 
 // function prototypes
 ConfigDataType *clearConfigData(ConfigDataType *configData);
 void displayConfigData(ConfigDataType *configData);
 Boolean getConfigData(char *fileName, ConfigDataType **configData, char *endStateMsg);
+void assignConfigValue(ConfigDataType *configData, int lineCode, int intVal, double doubleVal, char *stringVal);
+Boolean setConfigValue(ConfigDataType *configData, char *prompt, char *valueStr);
 void configCodeToString(int code, char *outString);
 int getDataLineCode(char *dataBuffer);
+Boolean isOptionalDataLine(int lineCode);
+Boolean isOptionalLineNext(FileBufferType *filePtr);
 Boolean valueInRange(int lineCode, int intVal, double doubleVal, char *stringVal);
 ConfigDataCodes getCpuSchedCode(char *codestr);
 ConfigDataCodes getLogToCode(char *logToStr);
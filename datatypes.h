@@ -19,17 +19,79 @@ typedef struct ConfigDataType {
     int ioCycleRate;
     int logToCode;
     char logToFileName[100];
+    int clockModeCode;
+    int logFullCode;
+    int memAllocCode;
+    int pageSize;
+    int pageReplaceCode;
+    int pageFaultCycles;
+    int cpuCores;
+    int migrationCycles;
+    int metricsCode;
+    Boolean recordOverhead;
 } ConfigDataType;
 
+// op code commands, resolved from their keyword when the metadata is parsed
+typedef enum {
+    CMD_SYS,
+    CMD_APP,
+    CMD_DEV,
+    CMD_CPU,
+    CMD_MEM
+} OpCommandCode;
+
+// dev op code in/out directions, IO_NONE for every other command
+typedef enum {
+    IO_NONE,
+    IO_IN,
+    IO_OUT
+} OpInOutCode;
+
+// op code first string arguments, device names come first so they double as device indices
+typedef enum {
+    ARG_ETHERNET,
+    ARG_HARD_DRIVE,
+    ARG_KEYBOARD,
+    ARG_MONITOR,
+    ARG_PRINTER,
+    ARG_SERIAL,
+    ARG_SOUND_SIGNAL,
+    ARG_USB,
+    ARG_VIDEO_SIGNAL,
+    ARG_ACCESS,
+    ARG_ALLOCATE,
+    ARG_END,
+    ARG_PROCESS,
+    ARG_START
+} OpArgCode;
+
 typedef struct OpCodeType {
     int pid;
-    char command[5];
-    char inOutArg[5];
-    char strArg1[15];
+    unsigned char commandCode;
+    unsigned char inOutCode;
+    unsigned char argCode;
     int intArg2;
     int intArg3;
     double opEndTime;
-    struct OpCodeType *nextNode;
 } OpCodeType;
 
+// op index range of one process, from its app start op to its app end op
+typedef struct ProcessRangeType {
+    int startIndex;
+    int endIndex;
+} ProcessRangeType;
+
+// contiguous op code program with the op range of every process
+typedef struct OpProgramType {
+    OpCodeType *ops;
+    int opCount;
+    int opCapacity;
+    ProcessRangeType *processes;
+    int processCount;
+    int processCapacity;
+    // set when the arrays live in a mapped metadata cache file instead of the heap
+    void *mapping;
+    long long mappingSize;
+} OpProgramType;
+
 #endif
@@ -0,0 +1,189 @@
+#include "devicepool.h"
+
+const int DEVICE_NOT_FOUND = -1;
+
+/**
+ * Find the worker index for a device
+ * @param argCode first string argument code of a dev op code
+ * @return index of the device worker, DEVICE_NOT_FOUND if the argument is not a device
+ */
+int getDeviceIndex(int argCode) {
+    if (argCode < 0 || argCode >= DEVICE_COUNT) {
+        return DEVICE_NOT_FOUND;
+    }
+    return argCode;
+}
+
+/**
+ * Main method for a device worker thread.
+ * Waits for queued ops, sleeps until each one is done, then posts it to the simulator as an interrupt.
+ */
+void *deviceWorkerThread(void *args) {
+    DeviceWorkerType *worker = (DeviceWorkerType *) args;
+    DevicePoolType *pool = worker->pool;
+    if (pool->overhead != NULL) {
+        worker->startLatency = getMonotonicNanoTime() - worker->createTime;
+    }
+
+    pthread_mutex_lock(&worker->lock);
+    while (True) {
+        while (worker->head == NULL && worker->shutdown == False) {
+            pthread_cond_wait(&worker->requestReady, &worker->lock);
+        }
+        // only stop once the queue is empty
+        if (worker->head == NULL) {
+            break;
+        }
+        DeviceRequestType *request = worker->head;
+        worker->head = request->next;
+        if (worker->head == NULL) {
+            worker->tail = NULL;
+        }
+        pthread_mutex_unlock(&worker->lock);
+
+        // run the device op
+        recordSleepUntil(pool->clockStartTime + request->endTime, worker->waitStats);
+
+        // interrupt the simulator
+        postInterrupt(pool->interrupts, request->pid, request->op, request->endTime,
+                      getMonotonicTime() - pool->clockStartTime);
+        free(request);
+
+        pthread_mutex_lock(&worker->lock);
+    }
+    pthread_mutex_unlock(&worker->lock);
+    return NULL;
+}
+
+/**
+ * Create the device pool. In real time mode one worker thread is started per device class,
+ * a virtual clock only needs the device timelines.
+ * @param clock simulation clock the devices run on
+ * @param overhead overhead histograms the workers' sleeps, starts and joins go to, NULL to not record them
+ * @return new device pool
+ */
+DevicePoolType *createDevicePool(SimClockType *clock, SimOverheadType *overhead) {
+    DevicePoolType *pool = calloc(1, sizeof(DevicePoolType));
+    pool->mode = clock->mode;
+    pool->clockStartTime = clock->startTime;
+    pool->overhead = overhead;
+    if (pool->mode == CLOCK_VIRTUAL_CODE) {
+        return pool;
+    }
+
+    pool->interrupts = createInterruptQueue();
+    for (int index = 0; index < DEVICE_COUNT; index++) {
+        DeviceWorkerType *worker = &pool->workers[index];
+        worker->pool = pool;
+        pthread_mutex_init(&worker->lock, NULL);
+        pthread_cond_init(&worker->requestReady, NULL);
+        // each worker times its sleeps on its own, they are merged once it is joined
+        if (overhead != NULL) {
+            worker->waitStats = calloc(1, sizeof(TimerStatsType));
+            worker->createTime = getMonotonicNanoTime();
+        }
+        pthread_create(&worker->thread, NULL, deviceWorkerThread, worker);
+    }
+    return pool;
+}
+
+/**
+ * Stop the device workers and free the device pool
+ * @param pool device pool
+ * @return NULL
+ */
+DevicePoolType *clearDevicePool(DevicePoolType *pool) {
+    if (pool == NULL) {
+        return NULL;
+    }
+    if (pool->mode == CLOCK_REAL_CODE) {
+        for (int index = 0; index < DEVICE_COUNT; index++) {
+            DeviceWorkerType *worker = &pool->workers[index];
+            long long joinStart = getMonotonicNanoTime();
+            pthread_mutex_lock(&worker->lock);
+            worker->shutdown = True;
+            pthread_cond_signal(&worker->requestReady);
+            pthread_mutex_unlock(&worker->lock);
+            pthread_join(worker->thread, NULL);
+            if (pool->overhead != NULL) {
+                recordHistogram(&pool->overhead->threadJoin, getMonotonicNanoTime() - joinStart);
+                recordHistogram(&pool->overhead->threadStart, worker->startLatency);
+                mergeTimerStats(&pool->overhead->deviceWaits, worker->waitStats);
+                free(worker->waitStats);
+            }
+            pthread_mutex_destroy(&worker->lock);
+            pthread_cond_destroy(&worker->requestReady);
+        }
+
+        // drop any interrupts the simulator never took
+        pool->interrupts = clearInterruptQueue(pool->interrupts);
+    }
+    free(pool);
+    return NULL;
+}
+
+/**
+ * Queue a device op on its device. A device serves one op at a time in the order they were submitted.
+ * @param pool device pool
+ * @param pid process issuing the op
+ * @param op dev op code
+ * @param startTime ideal simulation time the op was issued at
+ * @param duration time the op takes on the device, in microseconds
+ * @return ideal simulation time the op will finish at
+ */
+long long submitDeviceOp(DevicePoolType *pool, int pid, OpCodeType *op, long long startTime, long long duration) {
+    DeviceWorkerType *worker = &pool->workers[getDeviceIndex(op->argCode)];
+
+    // the device timeline is only touched by the simulator thread
+    if (worker->freeTime > startTime) {
+        startTime = worker->freeTime;
+    }
+    worker->freeTime = startTime + duration;
+
+    if (pool->mode == CLOCK_REAL_CODE) {
+        DeviceRequestType *request = malloc(sizeof(DeviceRequestType));
+        request->pid = pid;
+        request->op = op;
+        request->endTime = worker->freeTime;
+        request->next = NULL;
+
+        pthread_mutex_lock(&worker->lock);
+        if (worker->tail == NULL) {
+            worker->head = request;
+        } else {
+            worker->tail->next = request;
+        }
+        worker->tail = request;
+        pthread_cond_signal(&worker->requestReady);
+        pthread_mutex_unlock(&worker->lock);
+    }
+    return worker->freeTime;
+}
+
+/**
+ * Wait until a device op has finished or the deadline passes
+ * @param pool device pool
+ * @param deadline simulation time to stop waiting at, negative to wait without a deadline
+ * @return True if there is a completion to take
+ */
+Boolean waitForDeviceCompletion(DevicePoolType *pool, long long deadline) {
+    // virtual devices finish through the event queue
+    if (pool->mode == CLOCK_VIRTUAL_CODE) {
+        return False;
+    }
+
+    return waitForInterrupt(pool->interrupts, deadline < 0 ? -1 : pool->clockStartTime + deadline);
+}
+
+/**
+ * Take the oldest interrupt of a finished device op
+ * @param pool device pool
+ * @param completion output for the interrupt
+ * @return False if no device op has finished
+ */
+Boolean takeDeviceCompletion(DevicePoolType *pool, InterruptType *completion) {
+    if (pool->mode == CLOCK_VIRTUAL_CODE) {
+        return False;
+    }
+    return takeInterrupt(pool->interrupts, completion);
+}
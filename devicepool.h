@@ -0,0 +1,65 @@
+#ifndef DEVICEPOOL_H
+#define DEVICEPOOL_H
+
+#include <pthread.h>
+#include "datatypes.h"
+#include "StringUtils.h"
+#include "simclock.h"
+#include "interruptqueue.h"
+
+// GLOBAL CONSTANTS
+// one worker per device class accepted by verifyFirstStringArg, device arg codes are the worker indices
+#define DEVICE_COUNT (ARG_VIDEO_SIGNAL + 1)
+
+extern const int DEVICE_NOT_FOUND;
+
+/**
+ * A device op waiting for a device worker
+ */
+typedef struct DeviceRequestType {
+    int pid;
+    OpCodeType *op;
+    long long endTime;
+    struct DeviceRequestType *next;
+} DeviceRequestType;
+
+struct DevicePoolType;
+
+/**
+ * Long-lived thread that serves the queued ops of one device class in order.
+ * With overhead recording on it times its own sleeps and how long it took to start.
+ */
+typedef struct DeviceWorkerType {
+    struct DevicePoolType *pool;
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t requestReady;
+    DeviceRequestType *head;
+    DeviceRequestType *tail;
+    long long freeTime;
+    Boolean shutdown;
+    TimerStatsType *waitStats;
+    long long createTime;
+    long long startLatency;
+} DeviceWorkerType;
+
+/**
+ * Pool of device workers, plus the queue they post finished ops to as interrupts
+ */
+typedef struct DevicePoolType {
+    int mode;
+    long long clockStartTime;
+    DeviceWorkerType workers[DEVICE_COUNT];
+    InterruptQueueType *interrupts;
+    SimOverheadType *overhead;
+} DevicePoolType;
+
+// function prototypes
+int getDeviceIndex(int argCode);
+DevicePoolType *createDevicePool(SimClockType *clock, SimOverheadType *overhead);
+DevicePoolType *clearDevicePool(DevicePoolType *pool);
+long long submitDeviceOp(DevicePoolType *pool, int pid, OpCodeType *op, long long startTime, long long duration);
+Boolean waitForDeviceCompletion(DevicePoolType *pool, long long deadline);
+Boolean takeDeviceCompletion(DevicePoolType *pool, InterruptType *completion);
+
+#endif
@@ -0,0 +1,134 @@
+#include "eventqueue.h"
+
+/**
+ * Check if one event has to run before another one
+ * @param one first event
+ * @param other second event
+ * @return True if one comes before other
+ */
+static Boolean eventBefore(SimEventType *one, SimEventType *other) {
+    if (one->time != other->time) {
+        return one->time < other->time;
+    }
+    // events at the same time run in the order they were scheduled
+    return one->sequence < other->sequence;
+}
+
+/**
+ * Create an empty event queue
+ * @param capacity initial amount of events the queue can hold
+ * @return new event queue
+ */
+EventQueueType *createEventQueue(int capacity) {
+    EventQueueType *queue = calloc(1, sizeof(EventQueueType));
+    if (capacity < 1) {
+        capacity = 1;
+    }
+    queue->events = malloc(capacity * sizeof(SimEventType));
+    queue->capacity = capacity;
+    return queue;
+}
+
+/**
+ * Free an event queue
+ * @param queue event queue
+ * @return NULL
+ */
+EventQueueType *clearEventQueue(EventQueueType *queue) {
+    if (queue != NULL) {
+        free(queue->events);
+        free(queue);
+    }
+    return NULL;
+}
+
+/**
+ * Schedule an event to happen at the given simulation time
+ * @param queue event queue
+ * @param time simulation time in microseconds
+ * @param code event code
+ * @param pid process the event belongs to
+ * @param op op code the event belongs to
+ */
+void scheduleEvent(EventQueueType *queue, long long time, int code, int pid, OpCodeType *op) {
+    // grow the heap when it is full
+    if (queue->count == queue->capacity) {
+        queue->capacity *= 2;
+        queue->events = realloc(queue->events, queue->capacity * sizeof(SimEventType));
+    }
+
+    SimEventType event;
+    event.time = time;
+    event.sequence = queue->nextSequence++;
+    event.code = code;
+    event.pid = pid;
+    event.op = op;
+
+    // sift the new event up from the bottom of the heap
+    int index = queue->count++;
+    while (index > 0) {
+        int parent = (index - 1) / 2;
+        if (!eventBefore(&event, &queue->events[parent])) {
+            break;
+        }
+        queue->events[index] = queue->events[parent];
+        index = parent;
+    }
+    queue->events[index] = event;
+}
+
+/**
+ * Remove the earliest event from the queue
+ * @param queue event queue
+ * @param event output for the removed event
+ * @return False if the queue was empty
+ */
+Boolean popEvent(EventQueueType *queue, SimEventType *event) {
+    if (queue->count == 0) {
+        return False;
+    }
+    *event = queue->events[0];
+
+    // sift the last event down from the top of the heap
+    SimEventType last = queue->events[--queue->count];
+    int index = 0;
+    while (True) {
+        int child = index * 2 + 1;
+        if (child >= queue->count) {
+            break;
+        }
+        if (child + 1 < queue->count && eventBefore(&queue->events[child + 1], &queue->events[child])) {
+            child++;
+        }
+        if (!eventBefore(&queue->events[child], &last)) {
+            break;
+        }
+        queue->events[index] = queue->events[child];
+        index = child;
+    }
+    queue->events[index] = last;
+    return True;
+}
+
+/**
+ * Look at the earliest event without removing it
+ * @param queue event queue
+ * @param event output for the earliest event
+ * @return False if the queue was empty
+ */
+Boolean peekEvent(EventQueueType *queue, SimEventType *event) {
+    if (queue->count == 0) {
+        return False;
+    }
+    *event = queue->events[0];
+    return True;
+}
+
+/**
+ * Check if there are no events left
+ * @param queue event queue
+ * @return True if the queue is empty
+ */
+Boolean isEventQueueEmpty(EventQueueType *queue) {
+    return queue->count == 0;
+}
@@ -0,0 +1,41 @@
+#ifndef EVENTQUEUE_H
+#define EVENTQUEUE_H
+
+#include "datatypes.h"
+
+// GLOBAL CONSTANTS
+typedef enum {
+    EVT_CPU_END,
+    EVT_IO_END
+} SimEventCode;
+
+/**
+ * A simulation event, ordered by time and then by the order it was scheduled in
+ */
+typedef struct SimEventType {
+    long long time;
+    long long sequence;
+    int code;
+    int pid;
+    OpCodeType *op;
+} SimEventType;
+
+/**
+ * Binary min-heap of simulation events
+ */
+typedef struct EventQueueType {
+    SimEventType *events;
+    int count;
+    int capacity;
+    long long nextSequence;
+} EventQueueType;
+
+// function prototypes
+EventQueueType *createEventQueue(int capacity);
+EventQueueType *clearEventQueue(EventQueueType *queue);
+void scheduleEvent(EventQueueType *queue, long long time, int code, int pid, OpCodeType *op);
+Boolean popEvent(EventQueueType *queue, SimEventType *event);
+Boolean peekEvent(EventQueueType *queue, SimEventType *event);
+Boolean isEventQueueEmpty(EventQueueType *queue);
+
+#endif
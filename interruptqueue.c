@@ -0,0 +1,161 @@
+#include <errno.h>
+#include <time.h>
+#include "interruptqueue.h"
+
+/**
+ * Link a node in at the head of the queue. The swap orders producers against each other,
+ * the node only becomes visible to the simulator once the previous head points at it.
+ * @param queue interrupt queue
+ * @param node node to link in
+ */
+static void pushInterruptNode(InterruptQueueType *queue, InterruptType *node) {
+    __atomic_store_n(&node->next, NULL, __ATOMIC_RELAXED);
+    InterruptType *previous = __atomic_exchange_n(&queue->head, node, __ATOMIC_SEQ_CST);
+    __atomic_store_n(&previous->next, node, __ATOMIC_SEQ_CST);
+}
+
+/**
+ * Unlink the oldest node from the tail of the queue, simulator thread only
+ * @param queue interrupt queue
+ * @return oldest node, NULL if the queue is empty or a producer is still linking its node in
+ */
+static InterruptType *popInterruptNode(InterruptQueueType *queue) {
+    InterruptType *tail = queue->tail;
+    InterruptType *next = __atomic_load_n(&tail->next, __ATOMIC_ACQUIRE);
+
+    // step over the stub, it only keeps the queue from ever being empty
+    if (tail == &queue->stub) {
+        if (next == NULL) {
+            return NULL;
+        }
+        queue->tail = next;
+        tail = next;
+        next = __atomic_load_n(&next->next, __ATOMIC_ACQUIRE);
+    }
+    if (next != NULL) {
+        queue->tail = next;
+        return tail;
+    }
+    // the tail is the last linked node, it can only go once the stub is behind it
+    if (tail != __atomic_load_n(&queue->head, __ATOMIC_ACQUIRE)) {
+        return NULL;
+    }
+    pushInterruptNode(queue, &queue->stub);
+    next = __atomic_load_n(&tail->next, __ATOMIC_ACQUIRE);
+    if (next != NULL) {
+        queue->tail = next;
+        return tail;
+    }
+    return NULL;
+}
+
+/**
+ * Check if an interrupt has been linked in, simulator thread only
+ * @param queue interrupt queue
+ * @return True if there is an interrupt to take
+ */
+static Boolean isInterruptPending(InterruptQueueType *queue) {
+    return queue->tail != &queue->stub || __atomic_load_n(&queue->stub.next, __ATOMIC_SEQ_CST) != NULL;
+}
+
+/**
+ * Create an empty interrupt queue
+ * @return new interrupt queue
+ */
+InterruptQueueType *createInterruptQueue() {
+    InterruptQueueType *queue = calloc(1, sizeof(InterruptQueueType));
+    queue->head = &queue->stub;
+    queue->tail = &queue->stub;
+
+    // interrupt waits use the same monotonic clock as the simulation clock
+    pthread_condattr_t conditionAttributes;
+    pthread_condattr_init(&conditionAttributes);
+    pthread_condattr_setclock(&conditionAttributes, CLOCK_MONOTONIC);
+    pthread_mutex_init(&queue->lock, NULL);
+    pthread_cond_init(&queue->interruptReady, &conditionAttributes);
+    pthread_condattr_destroy(&conditionAttributes);
+    return queue;
+}
+
+/**
+ * Free an interrupt queue and any interrupts the simulator never took, once every producer has stopped
+ * @param queue interrupt queue, or NULL
+ * @return NULL
+ */
+InterruptQueueType *clearInterruptQueue(InterruptQueueType *queue) {
+    if (queue == NULL) {
+        return NULL;
+    }
+    InterruptType *node;
+    while ((node = popInterruptNode(queue)) != NULL) {
+        free(node);
+    }
+    pthread_mutex_destroy(&queue->lock);
+    pthread_cond_destroy(&queue->interruptReady);
+    free(queue);
+    return NULL;
+}
+
+/**
+ * Post an interrupt from a device thread, waking the simulator if it sleeps on the queue
+ * @param queue interrupt queue
+ * @param pid process that issued the op
+ * @param op finished dev op code
+ * @param dueTime ideal simulation time the op finished at
+ * @param postTime simulation time the interrupt was posted at
+ */
+void postInterrupt(InterruptQueueType *queue, int pid, OpCodeType *op, long long dueTime, long long postTime) {
+    InterruptType *interrupt = malloc(sizeof(InterruptType));
+    interrupt->pid = pid;
+    interrupt->op = op;
+    interrupt->dueTime = dueTime;
+    interrupt->postTime = postTime;
+    pushInterruptNode(queue, interrupt);
+
+    if (__atomic_load_n(&queue->consumerSleeping, __ATOMIC_SEQ_CST) != 0) {
+        pthread_mutex_lock(&queue->lock);
+        pthread_cond_signal(&queue->interruptReady);
+        pthread_mutex_unlock(&queue->lock);
+    }
+}
+
+/**
+ * Take the oldest interrupt, simulator thread only
+ * @param queue interrupt queue
+ * @param interrupt output for the interrupt
+ * @return False if there is no interrupt to take
+ */
+Boolean takeInterrupt(InterruptQueueType *queue, InterruptType *interrupt) {
+    InterruptType *node = popInterruptNode(queue);
+    if (node == NULL) {
+        return False;
+    }
+    *interrupt = *node;
+    free(node);
+    return True;
+}
+
+/**
+ * Wait until an interrupt is posted or the deadline passes, simulator thread only
+ * @param queue interrupt queue
+ * @param deadline monotonic time to stop waiting at, negative to wait without a deadline
+ * @return True if there is an interrupt to take
+ */
+Boolean waitForInterrupt(InterruptQueueType *queue, long long deadline) {
+    struct timespec wakeTime;
+    wakeTime.tv_sec = (time_t) (deadline / 1000000);
+    wakeTime.tv_nsec = (long) (deadline % 1000000) * 1000;
+
+    pthread_mutex_lock(&queue->lock);
+    __atomic_store_n(&queue->consumerSleeping, 1, __ATOMIC_SEQ_CST);
+    while (isInterruptPending(queue) == False) {
+        if (deadline < 0) {
+            pthread_cond_wait(&queue->interruptReady, &queue->lock);
+        } else if (pthread_cond_timedwait(&queue->interruptReady, &queue->lock, &wakeTime) == ETIMEDOUT) {
+            break;
+        }
+    }
+    __atomic_store_n(&queue->consumerSleeping, 0, __ATOMIC_SEQ_CST);
+    pthread_mutex_unlock(&queue->lock);
+    return isInterruptPending(queue);
+}
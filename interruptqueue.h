@@ -0,0 +1,41 @@
+#ifndef INTERRUPTQUEUE_H
+#define INTERRUPTQUEUE_H
+
+#include <pthread.h>
+#include "datatypes.h"
+
+/**
+ * A finished device op, posted by the device thread that ran it
+ */
+typedef struct InterruptType {
+    int pid;
+    OpCodeType *op;
+    long long dueTime;
+    long long postTime;
+    struct InterruptType *next;
+} InterruptType;
+
+/**
+ * Lock-free multi producer, single consumer queue of interrupts.
+ * Producers only swap head, the simulator thread only moves tail, so posting never waits on the simulator.
+ * The lock and condition variable are only used to wake the simulator when it sleeps on an empty queue.
+ */
+typedef struct InterruptQueueType {
+    InterruptType stub;
+    char headPadding[64];
+    InterruptType *head;
+    char tailPadding[64];
+    InterruptType *tail;
+    int consumerSleeping;
+    pthread_mutex_t lock;
+    pthread_cond_t interruptReady;
+} InterruptQueueType;
+
+// function prototypes
+InterruptQueueType *createInterruptQueue();
+InterruptQueueType *clearInterruptQueue(InterruptQueueType *queue);
+void postInterrupt(InterruptQueueType *queue, int pid, OpCodeType *op, long long dueTime, long long postTime);
+Boolean takeInterrupt(InterruptQueueType *queue, InterruptType *interrupt);
+Boolean waitForInterrupt(InterruptQueueType *queue, long long deadline);
+
+#endif
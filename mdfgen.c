@@ -0,0 +1,427 @@
+#include <math.h>
+#include "datatypes.h"
+#include "StringUtils.h"
+#include "metadataops.h"
+#include "devicepool.h"
+
+// GLOBAL CONSTANTS
+const int MAX_DRAWN_VALUE = 1000000;
+const int OUTPUT_BUFFER_SIZE = 1 << 20;
+// later allocations of a process are still made, accesses only land in the first ones
+const int MAX_TRACKED_SEGMENTS = 256;
+
+typedef enum {
+    DIST_CONSTANT,
+    DIST_UNIFORM,
+    DIST_EXPONENTIAL,
+    DIST_BIMODAL
+} DistributionCode;
+
+typedef enum {
+    MEM_PATTERN_DISJOINT,
+    MEM_PATTERN_SHARED
+} MemPatternCode;
+
+/**
+ * A distribution values are drawn from.
+ * constant: first. uniform: first to second. exponential: mean first.
+ * bimodal: around first, or around second with a chance of percent, each within half its mean.
+ */
+typedef struct DistributionType {
+    int code;
+    double first;
+    double second;
+    double percent;
+} DistributionType;
+
+/**
+ * Generator settings, every value drawn comes from the one seeded random sequence
+ */
+typedef struct GeneratorType {
+    unsigned long long state;
+    long long processCount;
+    DistributionType opCount;
+    int cpuPercent;
+    int memPercent;
+    int deviceWeights[DEVICE_COUNT];
+    int deviceWeightTotal;
+    DistributionType cpuCycles;
+    DistributionType ioCycles;
+    DistributionType memSize;
+    int memPattern;
+    int memAvailable;
+} GeneratorType;
+
+/**
+ * A segment a generated process has allocated, so later accesses can land in it
+ */
+typedef struct GeneratedSegmentType {
+    int base;
+    int size;
+} GeneratedSegmentType;
+
+/**
+ * Get the next value of the random sequence, splitmix64, so a seed gives the same sequence everywhere
+ * @param generator generator
+ * @return 64 random bits
+ */
+unsigned long long nextRandom(GeneratorType *generator) {
+    unsigned long long value = (generator->state += 0x9E3779B97F4A7C15ULL);
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31);
+}
+
+/**
+ * Get a random fraction
+ * @param generator generator
+ * @return value in [0, 1)
+ */
+double nextFraction(GeneratorType *generator) {
+    return (nextRandom(generator) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ * Get a random whole number in a range
+ * @param generator generator
+ * @param low lowest value
+ * @param high highest value
+ * @return value in [low, high]
+ */
+long long nextInRange(GeneratorType *generator, long long low, long long high) {
+    return low + (long long) (nextRandom(generator) % (unsigned long long) (high - low + 1));
+}
+
+/**
+ * Draw a whole number from a distribution
+ * @param generator generator
+ * @param distribution distribution
+ * @param minimum smallest value to return
+ * @return drawn value, at least minimum and at most MAX_DRAWN_VALUE
+ */
+int drawValue(GeneratorType *generator, DistributionType *distribution, int minimum) {
+    double value = distribution->first;
+    double mean;
+
+    switch (distribution->code) {
+        case DIST_UNIFORM:
+            value = (double) nextInRange(generator, (long long) distribution->first, (long long) distribution->second);
+            break;
+        case DIST_EXPONENTIAL:
+            value = -distribution->first * log(1.0 - nextFraction(generator));
+            break;
+        case DIST_BIMODAL:
+            mean = nextFraction(generator) * 100.0 < distribution->percent ? distribution->second : distribution->first;
+            value = mean * (0.5 + nextFraction(generator));
+            break;
+    }
+    if (value < minimum) {
+        return minimum;
+    }
+    return value > MAX_DRAWN_VALUE ? MAX_DRAWN_VALUE : (int) (value + 0.5);
+}
+
+/**
+ * Read a non negative number that makes up the whole of a string
+ * @param text string
+ * @param value output number
+ * @return False if the string is not a number
+ */
+Boolean parseNumber(char *text, double *value) {
+    char *endPtr;
+    *value = strtod(text, &endPtr);
+    return endPtr != text && *endPtr == NULL_CHAR && *value >= 0.0;
+}
+
+/**
+ * Read a distribution: a number, uniform:<min>:<max>, exponential:<mean> or bimodal:<low>:<high>:<high percent>
+ * @param text distribution string
+ * @param distribution output distribution
+ * @return False if the string is not a distribution
+ */
+Boolean parseDistribution(char *text, DistributionType *distribution) {
+    char name[STD_STR_LEN];
+    char field[4][STD_STR_LEN];
+    double values[4];
+    int fieldCount = 0;
+    int length = 0;
+
+    // split at colons, the first field names the distribution
+    for (int index = 0; True; index++) {
+        if (text[index] == COLON || text[index] == NULL_CHAR) {
+            if (fieldCount == 4) {
+                return False;
+            }
+            field[fieldCount++][length] = NULL_CHAR;
+            length = 0;
+            if (text[index] == NULL_CHAR) {
+                break;
+            }
+        } else if (length < STD_STR_LEN - 1) {
+            field[fieldCount][length++] = text[index];
+        } else {
+            return False;
+        }
+    }
+    for (int index = 1; index < fieldCount; index++) {
+        if (parseNumber(field[index], &values[index]) == False) {
+            return False;
+        }
+    }
+    setStrToLowerCase(name, field[0]);
+    distribution->percent = 0.0;
+    if (fieldCount == 1 && parseNumber(field[0], &distribution->first) == True) {
+        distribution->code = DIST_CONSTANT;
+    } else if (compareString(name, "uniform") == STR_EQ && fieldCount == 3 && values[1] <= values[2]) {
+        distribution->code = DIST_UNIFORM;
+        distribution->first = values[1];
+        distribution->second = values[2];
+    } else if (compareString(name, "exponential") == STR_EQ && fieldCount == 2) {
+        distribution->code = DIST_EXPONENTIAL;
+        distribution->first = values[1];
+    } else if (compareString(name, "bimodal") == STR_EQ && fieldCount == 4 && values[3] <= 100.0) {
+        distribution->code = DIST_BIMODAL;
+        distribution->first = values[1];
+        distribution->second = values[2];
+        distribution->percent = values[3];
+    } else {
+        return False;
+    }
+    return True;
+}
+
+/**
+ * Read the device weights, a comma separated list with one weight per device in device order
+ * @param text weight list
+ * @param generator generator to set the weights of
+ * @return False if the list does not have a whole number for every device, or they are all 0
+ */
+Boolean parseDeviceWeights(char *text, GeneratorType *generator) {
+    char *position = text;
+    char *endPtr;
+
+    generator->deviceWeightTotal = 0;
+    for (int device = 0; device < DEVICE_COUNT; device++) {
+        long weight = strtol(position, &endPtr, 10);
+        if (endPtr == position || weight < 0 || weight > MAX_DRAWN_VALUE
+            || *endPtr != (device < DEVICE_COUNT - 1 ? COMMA : NULL_CHAR)) {
+            return False;
+        }
+        generator->deviceWeights[device] = (int) weight;
+        generator->deviceWeightTotal += (int) weight;
+        position = endPtr + 1;
+    }
+    return generator->deviceWeightTotal > 0;
+}
+
+/**
+ * Write a mem op of a process. The first one of a process allocates, later ones allocate or access
+ * one of its segments evenly. Disjoint processes allocate upwards through their own share of memory and
+ * never fault, once the share is used up they only access. A process with no share at all, when there are
+ * more processes than KB of memory, gets a cpu op instead. Shared processes allocate anywhere in memory and may overlap.
+ * @param generator generator
+ * @param output output file
+ * @param processIndex index of the process
+ * @param segments segments the process has allocated
+ * @param segmentCount number of segments
+ * @param nextBase next free address of a disjoint process
+ */
+void writeMemOp(GeneratorType *generator, FILE *output, long long processIndex, GeneratedSegmentType *segments,
+                int *segmentCount, long long *nextBase) {
+    long long shareSize = generator->memAvailable / generator->processCount;
+    long long shareEnd = shareSize * (processIndex + 1);
+    Boolean shareUsed = generator->memPattern == MEM_PATTERN_DISJOINT && *nextBase >= shareEnd;
+
+    if (shareUsed == True && *segmentCount == 0) {
+        fprintf(output, "cpu process, %d\n", drawValue(generator, &generator->cpuCycles, 1));
+        return;
+    }
+    if (*segmentCount > 0 && ((nextRandom(generator) & 1) == 0 || shareUsed == True)) {
+        GeneratedSegmentType *segment = &segments[nextInRange(generator, 0, *segmentCount - 1)];
+        int offset = (int) nextInRange(generator, 0, segment->size - 1);
+        int size = (int) nextInRange(generator, 1, segment->size - offset);
+        fprintf(output, "mem access, %d, %d\n", segment->base + offset, size);
+        return;
+    }
+    int size = drawValue(generator, &generator->memSize, 1);
+    int base;
+    if (generator->memPattern == MEM_PATTERN_DISJOINT) {
+        if (size > shareEnd - *nextBase) {
+            size = (int) (shareEnd - *nextBase);
+        }
+        base = (int) *nextBase;
+        *nextBase += size;
+    } else {
+        if (size > generator->memAvailable) {
+            size = generator->memAvailable;
+        }
+        base = (int) nextInRange(generator, 0, generator->memAvailable - size);
+    }
+    if (*segmentCount < MAX_TRACKED_SEGMENTS) {
+        segments[*segmentCount].base = base;
+        segments[*segmentCount].size = size;
+        (*segmentCount)++;
+    }
+    fprintf(output, "mem allocate, %d, %d\n", base, size);
+}
+
+/**
+ * Write a generated metadata file
+ * @param generator generator
+ * @param output output file
+ * @return number of ops written between the app start and app end of every process
+ */
+long long writeMetaData(GeneratorType *generator, FILE *output) {
+    GeneratedSegmentType *segments = malloc(MAX_TRACKED_SEGMENTS * sizeof(GeneratedSegmentType));
+    long long opTotal = 0;
+
+    fprintf(output, "Start Program Meta-Data Code:\nsys start\n");
+    for (long long processIndex = 0; processIndex < generator->processCount; processIndex++) {
+        int opCount = drawValue(generator, &generator->opCount, 0);
+        int segmentCount = 0;
+        long long nextBase = generator->memAvailable / generator->processCount * processIndex;
+
+        fprintf(output, "app start, 0\n");
+        for (int opIndex = 0; opIndex < opCount; opIndex++) {
+            int kind = (int) nextInRange(generator, 0, 99);
+            if (kind < generator->cpuPercent) {
+                fprintf(output, "cpu process, %d\n", drawValue(generator, &generator->cpuCycles, 1));
+            } else if (kind < generator->cpuPercent + generator->memPercent) {
+                writeMemOp(generator, output, processIndex, segments, &segmentCount, &nextBase);
+            } else {
+                int pick = (int) nextInRange(generator, 0, generator->deviceWeightTotal - 1);
+                int device = 0;
+                while (pick >= generator->deviceWeights[device]) {
+                    pick -= generator->deviceWeights[device++];
+                }
+                int inOut = (nextRandom(generator) & 1) == 0 ? IO_IN : IO_OUT;
+                fprintf(output, "dev %s, %s, %d\n", getInOutName(inOut), getArgName(device),
+                        drawValue(generator, &generator->ioCycles, 1));
+            }
+        }
+        fprintf(output, "app end\n");
+        opTotal += opCount;
+    }
+    fprintf(output, "sys end\nEnd Program Meta-Data Code.\n");
+    free(segments);
+    return opTotal;
+}
+
+/**
+ * Display the command line format of the generator
+ */
+void showGeneratorFormat() {
+    printf("Program Format:\n");
+    printf("     mdfgen [-s <seed>] [-p <processes>] [-o <ops>] [-c <cpu %%>] [-m <mem %%>] [-d <weights>]\n");
+    printf("         [-ct <cycles>] [-it <cycles>] [-ms <KB>] [-mp disjoint|shared] [-ma <KB>] <output file>\n");
+    printf("     -s  seed, the same seed and options always give the same file, 1 by default\n");
+    printf("     -p  number of processes, 10 by default\n");
+    printf("     -o  ops per process, 10 by default\n");
+    printf("     -c  percent of ops that are cpu ops, 50 by default\n");
+    printf("     -m  percent of ops that are mem ops, 0 by default, the rest are dev ops\n");
+    printf("     -d  comma separated weights of the devices, all 1 by default, in the order\n");
+    printf("        ");
+    for (int device = 0; device < DEVICE_COUNT; device++) {
+        printf(" %s%s", getArgName(device), device < DEVICE_COUNT - 1 ? "," : "\n");
+    }
+    printf("     -ct cycles of a cpu op, 10 by default\n");
+    printf("     -it cycles of a dev op, 20 by default\n");
+    printf("     -ms size of a mem allocate in KB, 1024 by default\n");
+    printf("     -mp mem allocate pattern, disjoint (default) shares memory out between processes,\n");
+    printf("         shared allocates anywhere so processes may collide\n");
+    printf("     -ma memory available in KB to allocate in, 11100 by default\n");
+    printf("     ops, cycles and sizes take a number or a distribution: uniform:<min>:<max>,\n");
+    printf("         exponential:<mean> or bimodal:<low mean>:<high mean>:<high percent>\n");
+}
+
+/**
+ * Generate a synthetic metadata file.
+ * Every value is drawn from one seeded sequence, so the same arguments always write the same bytes.
+ */
+int main(int argc, char **argv) {
+    GeneratorType generator = {0};
+    DistributionType *distribution = NULL;
+    double number;
+    Boolean argsValid = True;
+    int argIndex;
+
+    // defaults, a small mixed workload
+    generator.state = 1;
+    generator.processCount = 10;
+    generator.opCount = (DistributionType) {DIST_CONSTANT, 10, 0, 0};
+    generator.cpuPercent = 50;
+    generator.cpuCycles = (DistributionType) {DIST_CONSTANT, 10, 0, 0};
+    generator.ioCycles = (DistributionType) {DIST_CONSTANT, 20, 0, 0};
+    generator.memSize = (DistributionType) {DIST_CONSTANT, 1024, 0, 0};
+    generator.memPattern = MEM_PATTERN_DISJOINT;
+    generator.memAvailable = 11100;
+    for (int device = 0; device < DEVICE_COUNT; device++) {
+        generator.deviceWeights[device] = 1;
+    }
+    generator.deviceWeightTotal = DEVICE_COUNT;
+
+    // every option takes a value, the output file comes last
+    for (argIndex = 1; argsValid == True && argIndex < argc - 1; argIndex += 2) {
+        char *flag = argv[argIndex];
+        char *value = argv[argIndex + 1];
+        distribution = NULL;
+        if (compareString(flag, "-s") == STR_EQ) {
+            char *endPtr;
+            generator.state = strtoull(value, &endPtr, 10);
+            argsValid = endPtr != value && *endPtr == NULL_CHAR;
+        } else if (compareString(flag, "-p") == STR_EQ) {
+            argsValid = parseNumber(value, &number) && number >= 1 && number <= 100000000;
+            generator.processCount = (long long) number;
+        } else if (compareString(flag, "-c") == STR_EQ) {
+            argsValid = parseNumber(value, &number) && number <= 100;
+            generator.cpuPercent = (int) number;
+        } else if (compareString(flag, "-m") == STR_EQ) {
+            argsValid = parseNumber(value, &number) && number <= 100;
+            generator.memPercent = (int) number;
+        } else if (compareString(flag, "-d") == STR_EQ) {
+            argsValid = parseDeviceWeights(value, &generator);
+        } else if (compareString(flag, "-mp") == STR_EQ) {
+            if (compareString(value, "disjoint") == STR_EQ) {
+                generator.memPattern = MEM_PATTERN_DISJOINT;
+            } else if (compareString(value, "shared") == STR_EQ) {
+                generator.memPattern = MEM_PATTERN_SHARED;
+            } else {
+                argsValid = False;
+            }
+        } else if (compareString(flag, "-ma") == STR_EQ) {
+            argsValid = parseNumber(value, &number) && number >= 1 && number <= MAX_DRAWN_VALUE;
+            generator.memAvailable = (int) number;
+        } else if (compareString(flag, "-o") == STR_EQ) {
+            distribution = &generator.opCount;
+        } else if (compareString(flag, "-ct") == STR_EQ) {
+            distribution = &generator.cpuCycles;
+        } else if (compareString(flag, "-it") == STR_EQ) {
+            distribution = &generator.ioCycles;
+        } else if (compareString(flag, "-ms") == STR_EQ) {
+            distribution = &generator.memSize;
+        } else {
+            argsValid = False;
+        }
+        if (distribution != NULL) {
+            argsValid = parseDistribution(value, distribution);
+        }
+    }
+    if (argsValid == False || argIndex != argc - 1 || generator.cpuPercent + generator.memPercent > 100) {
+        showGeneratorFormat();
+        return 1;
+    }
+
+    FILE *output = fopen(argv[argIndex], "w");
+    if (output == NULL) {
+        printf("Output file %s can not be written\n", argv[argIndex]);
+        return 1;
+    }
+    setvbuf(output, NULL, _IOFBF, OUTPUT_BUFFER_SIZE);
+    long long opTotal = writeMetaData(&generator, output);
+    if (fclose(output) != 0) {
+        printf("Output file %s could not be written in full\n", argv[argIndex]);
+        return 1;
+    }
+    printf("Wrote %lld processes, %lld ops to %s\n", generator.processCount, opTotal, argv[argIndex]);
+    return 0;
+}
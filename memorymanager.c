@@ -0,0 +1,304 @@
+#include "memorymanager.h"
+
+// paged segments may lie anywhere an op argument can point
+const long long VIRTUAL_ADDRESS_LIMIT = 2147483648LL;
+
+/**
+ * Get the height of a subtree
+ * @param segment subtree root, or NULL
+ * @return height, 0 for an empty subtree
+ */
+static int getSegmentHeight(MemorySegmentType *segment) {
+    return segment == NULL ? 0 : segment->height;
+}
+
+/**
+ * Recompute the height and highest end address of a node from its children
+ * @param segment tree node
+ */
+static void updateSegment(MemorySegmentType *segment) {
+    int leftHeight = getSegmentHeight(segment->left);
+    int rightHeight = getSegmentHeight(segment->right);
+    segment->height = 1 + (leftHeight > rightHeight ? leftHeight : rightHeight);
+    segment->maxEnd = segment->end;
+    if (segment->left != NULL && segment->left->maxEnd > segment->maxEnd) {
+        segment->maxEnd = segment->left->maxEnd;
+    }
+    if (segment->right != NULL && segment->right->maxEnd > segment->maxEnd) {
+        segment->maxEnd = segment->right->maxEnd;
+    }
+}
+
+/**
+ * Rotate a subtree to the right
+ * @param segment subtree root
+ * @return new subtree root
+ */
+static MemorySegmentType *rotateSegmentRight(MemorySegmentType *segment) {
+    MemorySegmentType *newRoot = segment->left;
+    segment->left = newRoot->right;
+    newRoot->right = segment;
+    updateSegment(segment);
+    updateSegment(newRoot);
+    return newRoot;
+}
+
+/**
+ * Rotate a subtree to the left
+ * @param segment subtree root
+ * @return new subtree root
+ */
+static MemorySegmentType *rotateSegmentLeft(MemorySegmentType *segment) {
+    MemorySegmentType *newRoot = segment->right;
+    segment->right = newRoot->left;
+    newRoot->left = segment;
+    updateSegment(segment);
+    updateSegment(newRoot);
+    return newRoot;
+}
+
+/**
+ * Bring a subtree whose children differ in height by up to two back into balance
+ * @param segment subtree root
+ * @return new subtree root
+ */
+static MemorySegmentType *balanceSegment(MemorySegmentType *segment) {
+    updateSegment(segment);
+    int balance = getSegmentHeight(segment->left) - getSegmentHeight(segment->right);
+
+    if (balance > 1) {
+        if (getSegmentHeight(segment->left->left) < getSegmentHeight(segment->left->right)) {
+            segment->left = rotateSegmentLeft(segment->left);
+        }
+        return rotateSegmentRight(segment);
+    }
+    if (balance < -1) {
+        if (getSegmentHeight(segment->right->right) < getSegmentHeight(segment->right->left)) {
+            segment->right = rotateSegmentRight(segment->right);
+        }
+        return rotateSegmentLeft(segment);
+    }
+    return segment;
+}
+
+/**
+ * Insert a segment into a subtree
+ * @param root subtree root, or NULL
+ * @param segment new segment
+ * @return new subtree root
+ */
+static MemorySegmentType *insertSegment(MemorySegmentType *root, MemorySegmentType *segment) {
+    if (root == NULL) {
+        updateSegment(segment);
+        return segment;
+    }
+    if (segment->base < root->base) {
+        root->left = insertSegment(root->left, segment);
+    } else {
+        root->right = insertSegment(root->right, segment);
+    }
+    return balanceSegment(root);
+}
+
+/**
+ * Unlink the segment with the lowest base from a subtree
+ * @param root subtree root
+ * @param lowest output for the unlinked segment
+ * @return new subtree root
+ */
+static MemorySegmentType *removeLowestSegment(MemorySegmentType *root, MemorySegmentType **lowest) {
+    if (root->left == NULL) {
+        *lowest = root;
+        return root->right;
+    }
+    root->left = removeLowestSegment(root->left, lowest);
+    return balanceSegment(root);
+}
+
+/**
+ * Unlink a segment from a subtree, the segment itself is not freed
+ * @param root subtree root
+ * @param segment segment to unlink
+ * @return new subtree root
+ */
+static MemorySegmentType *removeSegment(MemorySegmentType *root, MemorySegmentType *segment) {
+    if (root == NULL) {
+        return NULL;
+    }
+    if (segment->base < root->base) {
+        root->left = removeSegment(root->left, segment);
+    } else if (segment->base > root->base) {
+        root->right = removeSegment(root->right, segment);
+    } else {
+        // the successor of a node with two children takes its place
+        if (root->left == NULL || root->right == NULL) {
+            return root->left != NULL ? root->left : root->right;
+        }
+        MemorySegmentType *successor;
+        MemorySegmentType *right = removeLowestSegment(root->right, &successor);
+        successor->left = root->left;
+        successor->right = right;
+        root = successor;
+    }
+    return balanceSegment(root);
+}
+
+/**
+ * Check if a range overlaps any live segment
+ * @param root tree root
+ * @param base first address of the range
+ * @param end address after the range
+ * @return True if some segment overlaps the range
+ */
+static Boolean findOverlap(MemorySegmentType *root, long long base, long long end) {
+    MemorySegmentType *segment = root;
+    while (segment != NULL) {
+        if (segment->base < end && base < segment->end) {
+            return True;
+        }
+        // a left subtree that ends before the range can not overlap it
+        if (segment->left != NULL && segment->left->maxEnd > base) {
+            segment = segment->left;
+        } else {
+            segment = segment->right;
+        }
+    }
+    return False;
+}
+
+/**
+ * Free every segment of a subtree
+ * @param root subtree root, or NULL
+ */
+static void freeSegments(MemorySegmentType *root) {
+    if (root != NULL) {
+        freeSegments(root->left);
+        freeSegments(root->right);
+        free(root);
+    }
+}
+
+/**
+ * Create a memory manager with nothing allocated.
+ * Without paging every segment has to lie in memAvailable, with paging only its frames do.
+ * @param configDataPtr config data, giving memory size, allocator and paging settings
+ * @return new memory manager
+ */
+MemoryManagerType *createMemoryManager(ConfigDataType *configDataPtr) {
+    MemoryManagerType *memory = calloc(1, sizeof(MemoryManagerType));
+    if (configDataPtr->pageSize > 0) {
+        memory->addressLimit = VIRTUAL_ADDRESS_LIMIT;
+        memory->pages = createPageTable(configDataPtr->pageReplaceCode, configDataPtr->pageSize,
+                                        configDataPtr->memAvailable);
+    } else {
+        memory->addressLimit = configDataPtr->memAvailable;
+        if (configDataPtr->memAllocCode != MEM_ALLOC_NONE_CODE) {
+            memory->physical = createPhysicalMemory(configDataPtr->memAllocCode, configDataPtr->memAvailable);
+        }
+    }
+    return memory;
+}
+
+/**
+ * Free a memory manager and every segment still allocated
+ * @param memory memory manager, or NULL
+ * @return NULL
+ */
+MemoryManagerType *clearMemoryManager(MemoryManagerType *memory) {
+    if (memory != NULL) {
+        freeSegments(memory->root);
+        clearPhysicalMemory(memory->physical);
+        clearPageTable(memory->pages);
+        free(memory);
+    }
+    return NULL;
+}
+
+/**
+ * Allocate a segment for a process
+ * @param memory memory manager
+ * @param pid process asking for the segment
+ * @param base first address of the segment
+ * @param size size of the segment
+ * @param processSegments segment list of the process, the new segment is added to it
+ * @return False if the segment is empty, lies outside memory, overlaps an allocated segment
+ *         or the physical allocator has no block for it
+ */
+Boolean allocateMemory(MemoryManagerType *memory, int pid, long long base, long long size,
+                       MemorySegmentType **processSegments) {
+    if (base < 0 || size <= 0 || base + size > memory->addressLimit
+        || findOverlap(memory->root, base, base + size) == True) {
+        return False;
+    }
+    int physicalBase = 0;
+    int physicalSize = 0;
+    if (memory->physical != NULL) {
+        physicalBase = allocatePhysical(memory->physical, (int) size, &physicalSize);
+        if (physicalBase == PHYSICAL_NO_BLOCK) {
+            return False;
+        }
+    }
+    MemorySegmentType *segment = calloc(1, sizeof(MemorySegmentType));
+    segment->physicalBase = physicalBase;
+    segment->physicalSize = physicalSize;
+    segment->base = base;
+    segment->end = base + size;
+    segment->pid = pid;
+    segment->nextInProcess = *processSegments;
+    *processSegments = segment;
+    memory->root = insertSegment(memory->root, segment);
+    memory->usedMemory += size;
+    memory->segmentCount++;
+    return True;
+}
+
+/**
+ * Check a memory access of a process
+ * @param memory memory manager
+ * @param pid process making the access
+ * @param base first address accessed
+ * @param size size of the access
+ * @return True if the whole range lies inside one segment of the process
+ */
+Boolean accessMemory(MemoryManagerType *memory, int pid, long long base, long long size) {
+    MemorySegmentType *segment = memory->root;
+    MemorySegmentType *candidate = NULL;
+
+    if (base < 0 || size <= 0) {
+        return False;
+    }
+    // find the segment with the highest base at or below the access
+    while (segment != NULL) {
+        if (base < segment->base) {
+            segment = segment->left;
+        } else {
+            candidate = segment;
+            segment = segment->right;
+        }
+    }
+    return candidate != NULL && candidate->pid == pid && base + size <= candidate->end;
+}
+
+/**
+ * Free every segment of a process
+ * @param memory memory manager
+ * @param processSegments segment list of the process, emptied
+ */
+void freeProcessMemory(MemoryManagerType *memory, MemorySegmentType **processSegments) {
+    MemorySegmentType *segment = *processSegments;
+    while (segment != NULL) {
+        MemorySegmentType *nextSegment = segment->nextInProcess;
+        memory->root = removeSegment(memory->root, segment);
+        if (memory->physical != NULL) {
+            releasePhysical(memory->physical, segment->physicalBase, segment->physicalSize);
+        }
+        if (memory->pages != NULL) {
+            releasePages(memory->pages, segment->base, segment->end);
+        }
+        memory->usedMemory -= segment->end - segment->base;
+        memory->segmentCount--;
+        free(segment);
+        segment = nextSegment;
+    }
+    *processSegments = NULL;
+}
@@ -0,0 +1,50 @@
+#ifndef MEMORYMANAGER_H
+#define MEMORYMANAGER_H
+
+#include "datatypes.h"
+#include "physicalmemory.h"
+#include "pagetable.h"
+
+// GLOBAL CONSTANTS
+extern const long long VIRTUAL_ADDRESS_LIMIT;
+
+/**
+ * An allocated memory segment, a node of the segment tree and of its process's segment list
+ */
+typedef struct MemorySegmentType {
+    long long base;
+    long long end;
+    long long maxEnd;
+    int height;
+    int pid;
+    int physicalBase;
+    int physicalSize;
+    struct MemorySegmentType *left;
+    struct MemorySegmentType *right;
+    struct MemorySegmentType *nextInProcess;
+} MemorySegmentType;
+
+/**
+ * Memory management unit. Live segments sit in an AVL tree ordered by base address,
+ * where each node also knows the highest end address below it, so overlaps are found in O(log n).
+ * An optional physical allocator backs every segment with a block of the pool,
+ * or with paging on, accessed pages are loaded into frames of the pool on demand.
+ */
+typedef struct MemoryManagerType {
+    MemorySegmentType *root;
+    PhysicalMemoryType *physical;
+    PageTableType *pages;
+    long long addressLimit;
+    long long usedMemory;
+    int segmentCount;
+} MemoryManagerType;
+
+// function prototypes
+MemoryManagerType *createMemoryManager(ConfigDataType *configDataPtr);
+MemoryManagerType *clearMemoryManager(MemoryManagerType *memory);
+Boolean allocateMemory(MemoryManagerType *memory, int pid, long long base, long long size,
+                       MemorySegmentType **processSegments);
+Boolean accessMemory(MemoryManagerType *memory, int pid, long long base, long long size);
+void freeProcessMemory(MemoryManagerType *memory, MemorySegmentType **processSegments);
+
+#endif
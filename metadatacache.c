@@ -0,0 +1,210 @@
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "metadatacache.h"
+
+const int METADATA_CACHE_VERSION = 1;
+
+static const char METADATA_CACHE_MAGIC[8] = {'S', 'I', 'M', 'M', 'D', 'C', 'A', 'C'};
+
+/**
+ * Build the cache file name for a metadata file: the .mdf extension is replaced by .mdc,
+ * any other name gets .mdc appended
+ * @param cacheName output buffer, at least four chars longer than the metadata file name
+ * @param fileName metadata file name
+ */
+void getMetaDataCacheName(char *cacheName, char *fileName) {
+    int fileNameLength = getStringLength(fileName);
+    int extensionIndex = findSubString(fileName, ".mdf");
+
+    copyString(cacheName, fileName);
+    if (extensionIndex != SUBSTRING_NOT_FOUND && extensionIndex == fileNameLength - 4) {
+        cacheName[extensionIndex] = NULL_CHAR;
+    }
+    concatenateString(cacheName, ".mdc");
+}
+
+/**
+ * Fill in the source fields of a cache header: size, modification time and a FNV-1a hash of the contents
+ * @param fileName metadata file name
+ * @param header cache header
+ * @return False if the metadata file can not be read
+ */
+static Boolean getSourceInfo(char *fileName, MetaDataCacheHeaderType *header) {
+    struct stat fileStat;
+    FileBufferType *filePtr = openFileBuffer(fileName);
+
+    if (filePtr == NULL || stat(fileName, &fileStat) != 0) {
+        closeFileBuffer(filePtr);
+        return False;
+    }
+    header->sourceSize = filePtr->size;
+    header->sourceModifiedSec = (long long) fileStat.st_mtim.tv_sec;
+    header->sourceModifiedNsec = (long long) fileStat.st_mtim.tv_nsec;
+    header->sourceHash = 14695981039346656037ULL;
+    for (long long index = 0; index < filePtr->size; index++) {
+        header->sourceHash ^= (unsigned char) filePtr->data[index];
+        header->sourceHash *= 1099511628211ULL;
+    }
+    closeFileBuffer(filePtr);
+    return True;
+}
+
+/**
+ * Check that a mapped cache body only holds what the parser could have produced.
+ * The source hash only covers the metadata file, so a damaged or edited cache with a good header
+ * would otherwise index past its arrays.
+ * @param programPtr op code program pointing into the mapping
+ * @return False if an op has an unknown code or pid, or a process range lies outside the ops
+ */
+static Boolean isCacheBodyValid(OpProgramType *programPtr) {
+    for (int index = 0; index < programPtr->opCount; index++) {
+        OpCodeType *op = &programPtr->ops[index];
+        if (op->commandCode > CMD_MEM || op->inOutCode > IO_OUT || op->argCode > ARG_START
+            || op->pid < 0 || (op->pid > 0 && op->pid >= programPtr->processCount)) {
+            return False;
+        }
+    }
+    // a process runs from the op after its app start up to its app end, or to the last op without one
+    for (int index = 0; index < programPtr->processCount; index++) {
+        ProcessRangeType *range = &programPtr->processes[index];
+        int lastIndex = range->endIndex == BAD_ARG_VAL ? programPtr->opCount - 1 : range->endIndex;
+        if (range->startIndex < 0 || range->startIndex > lastIndex || lastIndex >= programPtr->opCount) {
+            return False;
+        }
+    }
+    return True;
+}
+
+/**
+ * Map the compiled form of a metadata file. The program's arrays point straight into the mapping.
+ * @param fileName metadata file name
+ * @param source header holding the source fields of the metadata file as it is now
+ * @param programPtr output for the op code program
+ * @return False if there is no cache, or it is stale, corrupt or from another build
+ */
+Boolean loadMetaDataCache(char *fileName, MetaDataCacheHeaderType *source, OpProgramType **programPtr) {
+    char cacheName[MAX_STR_LEN];
+    struct stat cacheStat;
+
+    *programPtr = NULL;
+    getMetaDataCacheName(cacheName, fileName);
+    int fileDescriptor = open(cacheName, O_RDONLY);
+    if (fileDescriptor < 0) {
+        return False;
+    }
+    if (fstat(fileDescriptor, &cacheStat) != 0 || cacheStat.st_size < (off_t) sizeof(MetaDataCacheHeaderType)) {
+        close(fileDescriptor);
+        return False;
+    }
+    // private writable mapping, anything the simulator writes to an op stays out of the file
+    long long mappingSize = cacheStat.st_size;
+    void *mapping = mmap(NULL, (size_t) mappingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fileDescriptor, 0);
+    close(fileDescriptor);
+    if (mapping == MAP_FAILED) {
+        return False;
+    }
+
+    MetaDataCacheHeaderType *header = (MetaDataCacheHeaderType *) mapping;
+    long long expectedSize = (long long) sizeof(MetaDataCacheHeaderType)
+                             + (long long) header->opCount * (long long) sizeof(OpCodeType)
+                             + (long long) header->processCount * (long long) sizeof(ProcessRangeType);
+    if (memcmp(header->magic, METADATA_CACHE_MAGIC, sizeof(METADATA_CACHE_MAGIC)) != 0
+        || header->version != METADATA_CACHE_VERSION
+        || header->opSize != (int) sizeof(OpCodeType)
+        || header->opCount < 0 || header->processCount < 0
+        || expectedSize != mappingSize
+        || header->sourceSize != source->sourceSize
+        || header->sourceModifiedSec != source->sourceModifiedSec
+        || header->sourceModifiedNsec != source->sourceModifiedNsec
+        || header->sourceHash != source->sourceHash) {
+        munmap(mapping, (size_t) mappingSize);
+        return False;
+    }
+
+    OpProgramType *localProgramPtr = malloc(sizeof(OpProgramType));
+    localProgramPtr->ops = (OpCodeType *) ((char *) mapping + sizeof(MetaDataCacheHeaderType));
+    localProgramPtr->opCount = header->opCount;
+    localProgramPtr->opCapacity = header->opCount;
+    localProgramPtr->processes = (ProcessRangeType *) (localProgramPtr->ops + header->opCount);
+    localProgramPtr->processCount = header->processCount;
+    localProgramPtr->processCapacity = header->processCount;
+    localProgramPtr->mapping = mapping;
+    localProgramPtr->mappingSize = mappingSize;
+    if (isCacheBodyValid(localProgramPtr) == False) {
+        clearMetaData(localProgramPtr);
+        return False;
+    }
+    *programPtr = localProgramPtr;
+    return True;
+}
+
+/**
+ * Write the compiled form of a metadata file next to it.
+ * The cache is written to a temporary file first, so a reader never maps a half written cache.
+ * @param fileName metadata file name
+ * @param source header holding the source fields of the metadata file, taken before it was parsed
+ * @param programPtr op code program parsed from the file
+ * @return False if the cache could not be written
+ */
+Boolean writeMetaDataCache(char *fileName, MetaDataCacheHeaderType *source, OpProgramType *programPtr) {
+    char cacheName[MAX_STR_LEN];
+    char tempName[MAX_STR_LEN];
+    MetaDataCacheHeaderType header = *source;
+
+    memcpy(header.magic, METADATA_CACHE_MAGIC, sizeof(METADATA_CACHE_MAGIC));
+    header.version = METADATA_CACHE_VERSION;
+    header.opSize = (int) sizeof(OpCodeType);
+    header.opCount = programPtr->opCount;
+    header.processCount = programPtr->processCount;
+
+    getMetaDataCacheName(cacheName, fileName);
+    copyString(tempName, cacheName);
+    concatenateString(tempName, ".tmp");
+    FILE *cacheFile = fopen(tempName, "wb");
+    if (cacheFile == NULL) {
+        return False;
+    }
+    Boolean written = fwrite(&header, sizeof(MetaDataCacheHeaderType), 1, cacheFile) == 1
+        && fwrite(programPtr->ops, sizeof(OpCodeType), programPtr->opCount, cacheFile) == (size_t) programPtr->opCount
+        && fwrite(programPtr->processes, sizeof(ProcessRangeType), programPtr->processCount, cacheFile)
+           == (size_t) programPtr->processCount;
+    if (fclose(cacheFile) != 0 || written == False || rename(tempName, cacheName) != 0) {
+        remove(tempName);
+        return False;
+    }
+    return True;
+}
+
+/**
+ * Get the op code program of a metadata file, from its cache when the cache is current.
+ * Otherwise the file is parsed with getMetaData and the cache is rewritten.
+ * The source fields are taken once, before parsing, so a file edited during the parse leaves a cache
+ * that no longer matches it instead of one that passes for the new file.
+ * @param fileName metadata file name
+ * @param programPtr output for the op code program
+ * @param endStateMsg end state message
+ * @param forceCompile True to ignore any existing cache
+ * @return False on metadata upload failure
+ */
+Boolean getCompiledMetaData(char *fileName, OpProgramType **programPtr, char *endStateMsg, Boolean forceCompile) {
+    MetaDataCacheHeaderType source;
+
+    memset(&source, 0, sizeof(MetaDataCacheHeaderType));
+    // an unreadable file is reported by the parser
+    Boolean hasSource = getSourceInfo(fileName, &source);
+    if (hasSource == True && forceCompile == False && loadMetaDataCache(fileName, &source, programPtr) == True) {
+        copyString(endStateMsg, "Metadata file upload successful");
+        return True;
+    }
+    if (getMetaData(fileName, programPtr, endStateMsg) == False) {
+        return False;
+    }
+    // a directory we can not write to only costs the next run a parse
+    if (hasSource == True && *programPtr != NULL) {
+        writeMetaDataCache(fileName, &source, *programPtr);
+    }
+    return True;
+}
@@ -0,0 +1,33 @@
+#ifndef METADATACACHE_H
+#define METADATACACHE_H
+
+#include "datatypes.h"
+#include "StringUtils.h"
+#include "metadataops.h"
+
+// GLOBAL CONSTANTS
+extern const int METADATA_CACHE_VERSION;
+
+/**
+ * Header of a compiled metadata file. The op code and process range arrays follow it
+ * in their in-memory layout, so a cache is only valid for the build that wrote it.
+ */
+typedef struct MetaDataCacheHeaderType {
+    char magic[8];
+    int version;
+    int opSize;
+    long long sourceSize;
+    long long sourceModifiedSec;
+    long long sourceModifiedNsec;
+    unsigned long long sourceHash;
+    int opCount;
+    int processCount;
+} MetaDataCacheHeaderType;
+
+// function prototypes
+void getMetaDataCacheName(char *cacheName, char *fileName);
+Boolean loadMetaDataCache(char *fileName, MetaDataCacheHeaderType *source, OpProgramType **programPtr);
+Boolean writeMetaDataCache(char *fileName, MetaDataCacheHeaderType *source, OpProgramType *programPtr);
+Boolean getCompiledMetaData(char *fileName, OpProgramType **programPtr, char *endStateMsg, Boolean forceCompile);
+
+#endif
@@ -1,53 +1,138 @@
+#include <sys/mman.h>
 #include "metadataops.h"
 
 const int BAD_ARG_VAL = -1;
 
+// keyword table entry
+typedef struct KeywordType {
+    char *name;
+    KeywordClass keywordClass;
+    int code;
+} KeywordType;
+
+// size of the keyword table, must stay a power of two for hashKeyword
+#define KEYWORD_TABLE_SIZE 32
+
+// every op code keyword sits in the slot hashKeyword computes for it, no two keywords share a slot
+static const KeywordType KEYWORD_TABLE[KEYWORD_TABLE_SIZE] = {
+    [1] = {"cpu", KEYWORD_COMMAND, CMD_CPU},
+    [2] = {"video signal", KEYWORD_ARG, ARG_VIDEO_SIGNAL},
+    [6] = {"end", KEYWORD_ARG, ARG_END},
+    [9] = {"sound signal", KEYWORD_ARG, ARG_SOUND_SIGNAL},
+    [11] = {"ethernet", KEYWORD_ARG, ARG_ETHERNET},
+    [12] = {"out", KEYWORD_IN_OUT, IO_OUT},
+    [13] = {"dev", KEYWORD_COMMAND, CMD_DEV},
+    [15] = {"hard drive", KEYWORD_ARG, ARG_HARD_DRIVE},
+    [16] = {"allocate", KEYWORD_ARG, ARG_ALLOCATE},
+    [18] = {"start", KEYWORD_ARG, ARG_START},
+    [19] = {"serial", KEYWORD_ARG, ARG_SERIAL},
+    [20] = {"access", KEYWORD_ARG, ARG_ACCESS},
+    [21] = {"keyboard", KEYWORD_ARG, ARG_KEYBOARD},
+    [22] = {"app", KEYWORD_COMMAND, CMD_APP},
+    [23] = {"sys", KEYWORD_COMMAND, CMD_SYS},
+    [24] = {"monitor", KEYWORD_ARG, ARG_MONITOR},
+    [25] = {"printer", KEYWORD_ARG, ARG_PRINTER},
+    [26] = {"process", KEYWORD_ARG, ARG_PROCESS},
+    [27] = {"in", KEYWORD_IN_OUT, IO_IN},
+    [28] = {"usb", KEYWORD_ARG, ARG_USB},
+    [31] = {"mem", KEYWORD_COMMAND, CMD_MEM}
+};
+
+// display names, indexed by op code enum values
+static char *COMMAND_NAMES[] = {"sys", "app", "dev", "cpu", "mem"};
+static char *IN_OUT_NAMES[] = {"", "in", "out"};
+static char *ARG_NAMES[] = {
+    "ethernet", "hard drive", "keyboard", "monitor", "printer", "serial", "sound signal", "usb", "video signal",
+    "access", "allocate", "end", "process", "start"
+};
+
 /*
- * Function Name: clearMetaDataList
- * Algorithm: recursively iterates through op code linked list, returns memory to OS from the bottom of the list upward
- * Precondition: linked list, with or without data
- * Postcondition: all node memory, if any, is returned to OS, return pointer (head) is set to null
+ * Function Name: clearMetaData
+ * Algorithm: returns the op code array and the process range array of the program to the OS,
+ *      or unmaps them if they were loaded from a metadata cache file
+ * Precondition: op code program, with or without data
+ * Postcondition: all program memory, if any, is returned to OS, return pointer is set to null
  * Exceptions: none
  * Notes: none
  */
-OpCodeType *clearMetaDataList(OpCodeType *localPtr) {
-    // check for local pointer not set to null (list not empty)
-    if (localPtr != NULL) {
-        // call recursive function with next pointer
-        clearMetaDataList(localPtr->nextNode);
-        // after recursive call, release memory to OS
-        free(localPtr);
-        // set local pointer to null
-        localPtr = NULL;
+OpProgramType *clearMetaData(OpProgramType *programPtr) {
+    // check for program pointer not set to null
+    if (programPtr != NULL) {
+        // check for program mapped from a cache file
+        if (programPtr->mapping != NULL) {
+            // unmap cache file
+            munmap(programPtr->mapping, (size_t) programPtr->mappingSize);
+        }
+        // otherwise, assume program built by the parser
+        else {
+            // release op code and process range arrays
+            free(programPtr->ops);
+            free(programPtr->processes);
+        }
+        // release program structure
+        free(programPtr);
     }
     // return null to calling function
     return NULL;
 }
 
+/*
+ * Function Name: createOpProgram
+ * Algorithm: allocates an empty op code program with initial array capacities
+ * Precondition: none
+ * Postcondition: returns pointer to empty program
+ * Exceptions: none
+ * Notes: assumes memory access/availability
+ */
+OpProgramType *createOpProgram() {
+    // init variables
+    const int INITIAL_OP_CAPACITY = 64;
+    const int INITIAL_PROCESS_CAPACITY = 8;
+    OpProgramType *programPtr = (OpProgramType *) malloc(sizeof(OpProgramType));
+    // allocate op code array
+    programPtr->ops = (OpCodeType *) malloc(INITIAL_OP_CAPACITY * sizeof(OpCodeType));
+    programPtr->opCount = 0;
+    programPtr->opCapacity = INITIAL_OP_CAPACITY;
+    // allocate process range array
+    programPtr->processes = (ProcessRangeType *) malloc(INITIAL_PROCESS_CAPACITY * sizeof(ProcessRangeType));
+    programPtr->processCount = 0;
+    programPtr->processCapacity = INITIAL_PROCESS_CAPACITY;
+    // program is not mapped from a cache file
+    programPtr->mapping = NULL;
+    programPtr->mappingSize = 0;
+    // return new program
+    return programPtr;
+}
+
 /*
  * Function Name: displayMetaData
- * Algorithm: iterates through op code linked list, displays op code data individually
- * Precondition: linked list, with or without data (should not be called if no data)
+ * Algorithm: iterates through op code array, displays op code data individually
+ * Precondition: op code program, with or without data (should not be called if no data)
  * Postcondition: displays all op codes in list
  * Exceptions: none
  * Notes: none
  */
-void displayMetaData(OpCodeType *localPtr) {
+void displayMetaData(OpProgramType *programPtr) {
+    // init variables
+    OpCodeType *localPtr;
+    int opIndex;
     // display title, with underline
     printf("Meta-Data File Display\n");
     printf("----------------------\n");
-    // loop to end of linked list
-    while (localPtr != NULL) {
+    // loop to end of op code array
+    for (opIndex = 0; opIndex < programPtr->opCount; opIndex++) {
+        // assign local pointer to current op code
+        localPtr = &programPtr->ops[opIndex];
         // print leader
         printf("Op Code: ");
         // print op code pid
         printf("/pid: %d", localPtr->pid);
         // print op code command
-        printf("/cmd: %s", localPtr->command);
+        printf("/cmd: %s", getCommandName(localPtr->commandCode));
         // check for dev op command
-        if (compareString(localPtr->command, "dev") == STR_EQ) {
+        if (localPtr->commandCode == CMD_DEV) {
             // print i/o parameter
-            printf("/io: %s", localPtr->inOutArg);
+            printf("/io: %s", getInOutName(localPtr->inOutCode));
         }
         // otherwise assume other than dev
         else {
@@ -55,7 +140,7 @@ void displayMetaData(OpCodeType *localPtr) {
             printf("/io: NA");
         }
         // print first string argument
-        printf("\n\t /arg 1: %s", localPtr->strArg1);
+        printf("\n\t /arg 1: %s", getArgName(localPtr->argCode));
         // print first int argument
         printf("/arg 2: %d", localPtr->intArg2);
         // print second int argument
@@ -64,39 +149,35 @@ void displayMetaData(OpCodeType *localPtr) {
         printf("/op end time: %8.6f", localPtr->opEndTime);
         // end line
         printf("\n\n");
-        // assign local pointer to next node
-        localPtr = localPtr->nextNode;
-    // end loop across nodes
+    // end loop across op codes
     }
 }
 
 /*
  * Function Name: getMetaData
- * Algorithm: acquires the metadata items from file, stores them in a linked list
+ * Algorithm: acquires the metadata items from file, stores them in a contiguous op code program
  * Precondition: provided file name
- * Postocndition: returns success (Boolean), returns linked list head via parameter, returns
+ * Postocndition: returns success (Boolean), returns op code program via parameter, returns
  *      endstate/error message via parameter
  * Exceptions: function halted and error message returned if bad input data
  * Notes: none
  */
-Boolean getMetaData(char *fileName, OpCodeType **opCodeDataHead, char *endStateMsg) {
+Boolean getMetaData(char *fileName, OpProgramType **programPtr, char *endStateMsg) {
     // initialize variables
-    // init read only constant
-    const char READ_ONLY_FLAG[] = "r";
     int accessResult, startCount = 0, endCount = 0;
     char dataBuffer[MAX_STR_LEN];
     Boolean ignoreLeadingWhiteSpace = True;
     Boolean stopAtNonPrintable = True;
     Boolean returnState = True;
-    OpCodeType *newNodePtr;
-    OpCodeType *localHeadPtr = NULL;
-    FILE *fileAccessPtr;
-    // init op code data pointer in case of return error
-    *opCodeDataHead = NULL;
+    OpCodeType newNode;
+    OpProgramType *localProgramPtr = NULL;
+    FileBufferType *fileAccessPtr;
+    // init op code program pointer in case of return error
+    *programPtr = NULL;
     // init end state message
     copyString(endStateMsg, "Metadata file upload successful");
-    // open file for reading
-    fileAccessPtr = fopen(fileName, READ_ONLY_FLAG);
+    // open file buffer for reading
+    fileAccessPtr = openFileBuffer(fileName);
     //check for file open failure
     if (fileAccessPtr == NULL) {
         // set end state message
@@ -108,49 +189,45 @@ Boolean getMetaData(char *fileName, OpCodeType **opCodeDataHead, char *endStateM
     if (getLineTo(fileAccessPtr, MAX_STR_LEN, COLON, dataBuffer, ignoreLeadingWhiteSpace, stopAtNonPrintable) != NO_ERR
         || compareString(dataBuffer, "Start Program Meta-Data Code") != STR_EQ) {
         // close file
-        fclose(fileAccessPtr);
+        fileAccessPtr = closeFileBuffer(fileAccessPtr);
         // set end state message
         copyString(endStateMsg, "Corrupt metadata leader line error");
         // return corrupt descriptor error
         return False;
     }
-    // allocate memory for the temp data structure
-    newNodePtr = (OpCodeType *) malloc(sizeof(OpCodeType));
     // get first op command
-    accessResult = getOpCommand(fileAccessPtr, newNodePtr);
+    accessResult = getOpCommand(fileAccessPtr, &newNode);
     // check for failure of first complete op command
     if (accessResult != COMPLETE_OPCMD_FOUND_MSG) {
         // close file
-        fclose(fileAccessPtr);
-        // clear data from the structure list
-        *opCodeDataHead = clearMetaDataList(localHeadPtr);
-        // free temp structure memory
-        free(newNodePtr);
+        fileAccessPtr = closeFileBuffer(fileAccessPtr);
         // set end state message
         copyString(endStateMsg, "Metadata incomplete first op command found");
         // return result of operation
         return False;
     }
+    // create the op code program
+    localProgramPtr = createOpProgram();
     // get start and end counts for later comparison
-    startCount = updateStartCount(startCount, newNodePtr->strArg1);
-    endCount = updateEndCount(endCount, newNodePtr->strArg1);
+    startCount = updateStartCount(startCount, newNode.argCode);
+    endCount = updateEndCount(endCount, newNode.argCode);
     // loop across all remaining op commands (while complete op commands are found)
     while (accessResult == COMPLETE_OPCMD_FOUND_MSG) {
-        // add the new op command to the linked list
-        localHeadPtr = addNode(localHeadPtr, newNodePtr);
+        // add the new op command to the program
+        addNode(localProgramPtr, &newNode);
         // get a new op command
-        accessResult = getOpCommand(fileAccessPtr, newNodePtr);
+        accessResult = getOpCommand(fileAccessPtr, &newNode);
         // update start and end counts for later comparison
-        startCount = updateStartCount(startCount, newNodePtr->strArg1);
-        endCount = updateEndCount(endCount, newNodePtr->strArg1);
+        startCount = updateStartCount(startCount, newNode.argCode);
+        endCount = updateEndCount(endCount, newNode.argCode);
     // end loop across remaining op commands
     }
     // after loop completion, check for last op command found
     if (accessResult == LAST_OPCMD_FOUND_MSG) {
         // check for start and end op code counts equal
         if (startCount == endCount) {
-            // add the last node to the linked list
-            localHeadPtr = addNode(localHeadPtr, newNodePtr);
+            // add the last node to the program
+            addNode(localProgramPtr, &newNode);
             // set access result to no error for later operation
             accessResult = NO_ERR;
             // check last line for incorrect end descriptor
@@ -172,175 +249,272 @@ Boolean getMetaData(char *fileName, OpCodeType **opCodeDataHead, char *endStateM
     }
     // check for any errors found (not no error)
     if (accessResult != NO_ERR) {
-        // clear the op command list
-        localHeadPtr = clearMetaDataList(localHeadPtr);
+        // clear the op code program
+        localProgramPtr = clearMetaData(localProgramPtr);
     }
     // close access file
-    fclose(fileAccessPtr);
-    // release temp struct memory
-    free(newNodePtr);
-    // assign temp local head pointer to parameter return return pointer
-    *opCodeDataHead = localHeadPtr;
+    fileAccessPtr = closeFileBuffer(fileAccessPtr);
+    // assign local program pointer to parameter return pointer
+    *programPtr = localProgramPtr;
     // return access result
     return returnState;
 }
 
 /*
  * Function Name: getOpCommand
- * Algorithm: acquires one op command, verifies all parts of it, returns as a parameter
+ * Algorithm: acquires one op command, verifies all parts of it, returns as a parameter; the command, in/out,
+ *      first string argument and number arguments are tokenized straight from the file buffer in one pass,
+ *      each one checked as soon as it is complete
  * Precondition: file is open and file cursor is at beginning of an op code
  * Postcondition: in correct operations, finds, tests and returns op command as parameter, and returns status as integer
- *      - either complete op command found, or last op command found
+ *      - either complete op command found, or last op command found; the cursor is left after the op command
  * Exceptions: correctly and appropriately (without program failure) responds to and reports file access failure,
  *      incorrectly formatted op command letter, incorrectly formatted op command name, incorrect or out of range
  *      op command value
- * Notes: none
+ * Notes: an op command ends at a semicolon, a non printable char or the end of the file; one of STD_STR_LEN - 1
+ *      chars or more is an access failure, whatever else is wrong with it
  */
-int getOpCommand(FILE *filePtr, OpCodeType *inData) {
+int getOpCommand(FileBufferType *filePtr, OpCodeType *inData) {
     // init variables
         // init local constants
         const int MAX_CMD_LENGTH = 5;
         const int MAX_ARG_STR_LENGTH = 15;
+        const int COMMAND_LENGTH = 3;
+        // init local copy of file cursor
+        char *data = filePtr->data;
+        long long position = filePtr->position;
+        long long size = filePtr->size;
+        long long startPosition, limit;
         // init other variables
-        int accessResult, numBuffer = 0;
-        char strBuffer[STD_STR_LEN];
         char cmdBuffer[MAX_CMD_LENGTH];
         char argStrBuffer[MAX_ARG_STR_LENGTH];
-        int runningStringIndex = 0;
-        Boolean stopAtNonPrintable = True;
-        Boolean arg2FailureFlag = False;
-        Boolean arg3FailureFlag = False;
-    // get whole op command as a string
-    accessResult = getLineTo(filePtr, STD_STR_LEN, SEMICOLON, strBuffer, IGNORE_LEADING_WS, stopAtNonPrintable);
-    // check for successful access
-    if (accessResult == NO_ERR) {
-        // get three-letter command
-        runningStringIndex = getCommand(cmdBuffer, strBuffer, runningStringIndex);
-        // assign op command to node
-        copyString(inData->command, cmdBuffer);
-    }
-    // otherwise, assume unsuccessful access
-    else {
-        // set pointer to data structure to null
-        inData = NULL;
-        // return op command access failure
+        int tokenLength = 0;
+        int numBuffer = 0;
+        int numberCount = 0;
+        int charAsInt;
+        int opResult = COMPLETE_OPCMD_FOUND_MSG;
+        OpTokenState state = OP_TOKEN_COMMAND;
+    // loop to skip leading white space
+    while (position < size && data[position] != SEMICOLON && (unsigned char) data[position] <= (unsigned char) SPACE) {
+        // move past white space char
+        position++;
+    }
+    // op command may not run past its last readable char
+    startPosition = position;
+    limit = startPosition + STD_STR_LEN - 1 < size ? startPosition + STD_STR_LEN - 1 : size;
+    // loop across op command chars
+    while (position < limit) {
+        // get char, check for end of op command
+        charAsInt = (unsigned char) data[position];
+        if (charAsInt == (int) SEMICOLON || charAsInt < ' ' || charAsInt > '~') {
+            // end loop
+            break;
+        }
+        // handle char for the token being read
+        switch (state) {
+            case OP_TOKEN_COMMAND:
+                // add char to three-letter command, check it once complete
+                cmdBuffer[tokenLength] = (char) charAsInt;
+                tokenLength++;
+                position++;
+                if (tokenLength == COMMAND_LENGTH) {
+                    cmdBuffer[tokenLength] = NULL_CHAR;
+                    state = setOpCommandToken(inData, cmdBuffer, &opResult);
+                }
+                break;
+            case OP_TOKEN_WORD_START:
+            case OP_TOKEN_NUMBER_START:
+                // skip spaces and commas, otherwise start the token at this char
+                if (charAsInt == (int) SPACE || charAsInt == (int) COMMA) {
+                    position++;
+                } else {
+                    state = state == OP_TOKEN_WORD_START ? OP_TOKEN_WORD : OP_TOKEN_NUMBER;
+                    tokenLength = 0;
+                    numBuffer = 0;
+                }
+                break;
+            case OP_TOKEN_WORD:
+                // check for comma ending the string argument
+                if (charAsInt == (int) COMMA) {
+                    state = setOpStringToken(inData, argStrBuffer, tokenLength, MAX_ARG_STR_LENGTH, &opResult);
+                }
+                // otherwise, add char to string argument while it fits
+                else {
+                    if (tokenLength < MAX_ARG_STR_LENGTH - 1) {
+                        argStrBuffer[tokenLength] = (char) charAsInt;
+                    }
+                    tokenLength++;
+                }
+                position++;
+                break;
+            case OP_TOKEN_NUMBER:
+                // add digit to number
+                if (isDigit((char) charAsInt) == True) {
+                    numBuffer = numBuffer * 10 + (charAsInt - '0');
+                    tokenLength++;
+                    position++;
+                }
+                // otherwise, end number, leaving the char for the next token
+                else {
+                    state = setOpNumberToken(inData, numBuffer, tokenLength > 0, &numberCount, &opResult);
+                }
+                break;
+            default:
+                // skip rest of op command
+                position++;
+                break;
+        }
+    }
+    // end the token the op command ended in
+    if (state == OP_TOKEN_COMMAND) {
+        cmdBuffer[tokenLength] = NULL_CHAR;
+        state = setOpCommandToken(inData, cmdBuffer, &opResult);
+    } else if (state == OP_TOKEN_WORD) {
+        state = setOpStringToken(inData, argStrBuffer, tokenLength, MAX_ARG_STR_LENGTH, &opResult);
+    } else if (state == OP_TOKEN_NUMBER) {
+        state = setOpNumberToken(inData, numBuffer, tokenLength > 0, &numberCount, &opResult);
+    }
+    // check for op command ended before all its arguments
+    if (state != OP_TOKEN_REST) {
+        // set argument error
+        opResult = CORRUPT_OPCMD_ARG_ERR;
+    }
+    // check for op command too long to read
+    if (position - startPosition >= STD_STR_LEN - 1) {
+        // save cursor, return op command access failure
+        filePtr->position = position;
         return OPCMD_ACCESS_ERR;
     }
+    // check for end of file
+    if (position >= size) {
+        // set end of file flag
+        filePtr->endOfFile = True;
+    }
+    // otherwise, assume op command ended by a char
+    else {
+        // move past semicolon or non printable char
+        position++;
+    }
+    // save cursor
+    filePtr->position = position;
+    // return op command result
+    return opResult;
+}
+
+/*
+ * Function Name: setOpCommandToken
+ * Algorithm: looks up the op command code of a complete command token, assigns it and the argument defaults to the node
+ * Precondition: command token is a C-style string
+ * Postcondition: returns OP_TOKEN_WORD_START to read the string arguments next, OP_TOKEN_REST on error
+ * Exceptions: sets result to CORRUPT_OPCMD_ERR if the command is not known
+ * Notes: none
+ */
+OpTokenState setOpCommandToken(OpCodeType *inData, char *cmd, int *opResult) {
+    // look up op command code
+    int keywordCode = getKeywordCode(cmd, KEYWORD_COMMAND);
     // verify op command
-    if (verifyValidCommand(cmdBuffer) == False) {
-        // return op command error
-        return CORRUPT_OPCMD_ERR;
+    if (keywordCode == BAD_ARG_VAL) {
+        // set op command error, skip rest of op command
+        *opResult = CORRUPT_OPCMD_ERR;
+        return OP_TOKEN_REST;
     }
+    // assign op command code to node
+    inData->commandCode = (unsigned char) keywordCode;
     // set all struct values that may not be initialized to defaults
     inData->pid = 0;
-    inData->inOutArg[0] = NULL_CHAR;
+    inData->inOutCode = IO_NONE;
     inData->intArg2 = 0;
     inData->intArg3 = 0;
     inData->opEndTime = 0.0;
-    inData->nextNode = NULL;
-    // check for device command
-    if (compareString(cmdBuffer, "dev") == STR_EQ) {
-        // get in/out argument
-        runningStringIndex = getStringArg(argStrBuffer, strBuffer, runningStringIndex);
-        // set device in/out argument
-        copyString(inData->inOutArg, argStrBuffer);
-        // check correct argument
-        if (compareString(argStrBuffer, "in") != STR_EQ && compareString(argStrBuffer, "out") != STR_EQ) {
-            // return argument error
-            return CORRUPT_OPCMD_ARG_ERR;
-        }
-    }
-    // get first string arg
-    runningStringIndex = getStringArg(argStrBuffer, strBuffer, runningStringIndex);
-    // set device in/out argument
-    copyString(inData->strArg1, argStrBuffer);
-    // check for legitimate first string arg
-    if (verifyFirstStringArg(argStrBuffer) == False) {
-        // return argument error
-        return CORRUPT_OPCMD_ARG_ERR;
-    }
+    // read string arguments next
+    return OP_TOKEN_WORD_START;
+}
+
+/*
+ * Function Name: setOpStringToken
+ * Algorithm: looks up a complete string argument token, the in/out argument of a device command before its
+ *      first string argument, and assigns its code to the node
+ * Precondition: node has its op command code
+ * Postcondition: returns the token to read next, OP_TOKEN_REST once the op command is complete or on error
+ * Exceptions: sets result to CORRUPT_OPCMD_ARG_ERR if the argument is too long or not known,
+ *      LAST_OPCMD_FOUND_MSG for sys end
+ * Notes: a token of bufferSize chars or more can not be a keyword, only its start is kept
+ */
+OpTokenState setOpStringToken(OpCodeType *inData, char *strArg, int tokenLength, int bufferSize, int *opResult) {
+    // init variables
+    Boolean inOutArg = inData->commandCode == CMD_DEV && inData->inOutCode == IO_NONE;
+    int keywordCode = BAD_ARG_VAL;
+    // end string argument, look up its code if it fit
+    strArg[tokenLength < bufferSize - 1 ? tokenLength : bufferSize - 1] = NULL_CHAR;
+    if (tokenLength < bufferSize) {
+        keywordCode = getKeywordCode(strArg, inOutArg == True ? KEYWORD_IN_OUT : KEYWORD_ARG);
+    }
+    // check correct argument
+    if (keywordCode == BAD_ARG_VAL) {
+        // set argument error, skip rest of op command
+        *opResult = CORRUPT_OPCMD_ARG_ERR;
+        return OP_TOKEN_REST;
+    }
+    // check for device in/out argument
+    if (inOutArg == True) {
+        // set device in/out argument, read first string argument next
+        inData->inOutCode = (unsigned char) keywordCode;
+        return OP_TOKEN_WORD_START;
+    }
+    // set first string argument
+    inData->argCode = (unsigned char) keywordCode;
     // check for last op command found
-    if (compareString(inData->command, "sys") == STR_EQ && compareString(inData->strArg1, "end") == STR_EQ) {
-        // return last op command found
-        return LAST_OPCMD_FOUND_MSG;
-    }
-    // check for app start seconds argument
-    if (compareString(inData->command, "sys") == STR_EQ && compareString(inData->strArg1, "end") == STR_EQ) {
-        // get number arg
-        runningStringIndex = getNumberArg(&numBuffer, strBuffer, runningStringIndex);
-        // check for failed number access
-        if (numBuffer <= BAD_ARG_VAL) {
-            // set failure flag
-            arg2FailureFlag = True;
-        }
-        // set first in arg to number
-        inData->intArg2 = numBuffer;
-    }
-    // check for cpu cycle time
-    if (compareString(inData->command, "cpu") == STR_EQ) {
-        // get number argument
-        runningStringIndex = getNumberArg(&numBuffer, strBuffer, runningStringIndex);
-        // check for failed number access
-        if (numBuffer <= BAD_ARG_VAL) {
-            // set failure flag
-            arg2FailureFlag = True;
-        }
-        // set first int argument to number
-        inData->intArg2 = numBuffer;
-    }
-    // check for device cycle time
-    if (compareString(inData->command, "dev") == STR_EQ) {
-        // get number argument
-        runningStringIndex = getNumberArg(&numBuffer, strBuffer, runningStringIndex);
-        // check for failed number access
-        if (numBuffer <= BAD_ARG_VAL) {
-            // set failure flag
-            arg2FailureFlag = True;
-        }
-        // set first int argument to number
-        inData->intArg2 = numBuffer;
-    }
-    // check for memory base and offset
-    if (compareString(inData->command, "mem") == STR_EQ) {
-        // get number argument for base
-        runningStringIndex = getNumberArg(&numBuffer, strBuffer, runningStringIndex);
-        // check for failed number access
-        if (numBuffer <= BAD_ARG_VAL) {
-            // set failure flag
-            arg2FailureFlag = True;
-        }
-        // set first int argument to number
-        inData->intArg2 = numBuffer;
-        // get number argument for offset
-        runningStringIndex = getNumberArg(&numBuffer, strBuffer, runningStringIndex);
-        // check for failed number access
-        if (numBuffer <= BAD_ARG_VAL) {
-            // set failure flag
-            arg3FailureFlag = True;
-        }
-        // set second int argument to number
-        inData->intArg3 = numBuffer;
-    }
-    // check int args for upload failure
-    if (arg2FailureFlag == True || arg3FailureFlag == True) {
-        // return argument error
-        return CORRUPT_OPCMD_ARG_ERR;
-    }
-    // return complete op command found message
-    return COMPLETE_OPCMD_FOUND_MSG;
+    if (inData->commandCode == CMD_SYS && inData->argCode == ARG_END) {
+        // set last op command found
+        *opResult = LAST_OPCMD_FOUND_MSG;
+        return OP_TOKEN_REST;
+    }
+    // check for cpu cycle time, device cycle time or memory base
+    if (inData->commandCode == CMD_CPU || inData->commandCode == CMD_DEV || inData->commandCode == CMD_MEM) {
+        // read number argument next
+        return OP_TOKEN_NUMBER_START;
+    }
+    // op command is complete
+    return OP_TOKEN_REST;
+}
+
+/*
+ * Function Name: setOpNumberToken
+ * Algorithm: assigns a complete number argument token to the node, the memory offset after the memory base
+ * Precondition: node has its op command code and first string argument
+ * Postcondition: returns OP_TOKEN_NUMBER_START to read the memory offset next, OP_TOKEN_REST otherwise
+ * Exceptions: sets result to CORRUPT_OPCMD_ARG_ERR if the token has no digit
+ * Notes: none
+ */
+OpTokenState setOpNumberToken(OpCodeType *inData, int number, Boolean foundDigit, int *numberCount, int *opResult) {
+    // check for failed number access
+    if (foundDigit == False) {
+        // set argument error, skip rest of op command
+        *opResult = CORRUPT_OPCMD_ARG_ERR;
+        return OP_TOKEN_REST;
+    }
+    // set first or second int argument to number
+    (*numberCount)++;
+    if (*numberCount == 1) {
+        inData->intArg2 = number;
+    } else {
+        inData->intArg3 = number;
+    }
+    // read memory offset after memory base, otherwise op command is complete
+    return inData->commandCode == CMD_MEM && *numberCount == 1 ? OP_TOKEN_NUMBER_START : OP_TOKEN_REST;
 }
 
 /*
  * Function Name: updateStartCount
  * Algorithm: updates number of "start" op commands found in file
- * Precondition: count >= 0, op string has "start" or other op name
- * Postcondition: if op string has "start", input count + 1 is returned; otherwise, input count is returned unchanged
+ * Precondition: count >= 0, arg code is ARG_START or other first string argument code
+ * Postcondition: if arg code is ARG_START, input count + 1 is returned; otherwise, input count is returned unchanged
  * Exceptions: none
  * Notes: none
  */
-int updateStartCount(int count, char *opString) {
-    // check for "start" in op string
-    if (compareString(opString, "start") == STR_EQ) {
+int updateStartCount(int count, int argCode) {
+    // check for "start" arg code
+    if (argCode == ARG_START) {
         // return incremented start count
         return count + 1;
     }
@@ -351,14 +525,14 @@ int updateStartCount(int count, char *opString) {
 /*
  * Function Name: updateEndCount
  * Algorithm: updates nunber of "end" op commands found in file
- * Precondition: count >= 0, op string has "end" or other op name
- * Postcondition: if op string has "end", input count + 1 is returned; otherwise, input count is returned unchanged
+ * Precondition: count >= 0, arg code is ARG_END or other first string argument code
+ * Postcondition: if arg code is ARG_END, input count + 1 is returned; otherwise, input count is returned unchanged
  * Exceptions: none
  * Notes: none
  */
-int updateEndCount(int count, char *opString) {
-    // check for "end" in op string
-    if (compareString(opString, "end") == STR_EQ) {
+int updateEndCount(int count, int argCode) {
+    // check for "end" arg code
+    if (argCode == ARG_END) {
         // return incremented end count
         return count + 1;
     }
@@ -368,183 +542,162 @@ int updateEndCount(int count, char *opString) {
 
 /*
  * Function Name: addNode
- * Algorithm: adds op command structure with data to a linked list
- * Precondition: linked list pointer assigned to null or to one op command link, struct pointer assigned to op command
- *      struct data
- * Postcondition: assigns new structure node to beginning of linked list or and of established linked list
+ * Algorithm: appends op command structure with data to the end of the program op code array, growing the
+ *      array by doubling when it is full, and records the op range of each process
+ * Precondition: program pointer assigned to op code program, struct pointer assigned to op command struct data
+ * Postcondition: copies new op command to end of op code array, updates process ranges for app start/end
  * Exceptions: none
  * Notes: assumes memory access/availability
  */
-OpCodeType *addNode(OpCodeType *localPtr, OpCodeType *newNode) {
-    // check for local pointer to null
-    if (localPtr == NULL) {
-        // access memory for new link/node
-        localPtr = (OpCodeType *) malloc(sizeof(OpCodeType));
-        // assign all three values to newly created node
-        // assign next pointer to null
-        localPtr->pid = newNode->pid;
-        copyString(localPtr->command, newNode->command);
-        copyString(localPtr->inOutArg, newNode->inOutArg);
-        copyString(localPtr->strArg1, newNode->strArg1);
-        localPtr->intArg2 = newNode->intArg2;
-        localPtr->intArg3 = newNode->intArg3;
-        localPtr->opEndTime = newNode->opEndTime;
+void addNode(OpProgramType *programPtr, OpCodeType *newNode) {
+    // init variables
+    OpCodeType *localPtr;
+    ProcessRangeType *rangePtr;
+    // check for full op code array
+    if (programPtr->opCount == programPtr->opCapacity) {
+        // double op code array capacity
+        programPtr->opCapacity *= 2;
+        programPtr->ops = (OpCodeType *) realloc(programPtr->ops, programPtr->opCapacity * sizeof(OpCodeType));
+    }
+    // copy new op command to end of array
+    localPtr = &programPtr->ops[programPtr->opCount];
+    *localPtr = *newNode;
+    // check for app start op command
+    if (localPtr->commandCode == CMD_APP && localPtr->argCode == ARG_START) {
+        // check for full process range array
+        if (programPtr->processCount == programPtr->processCapacity) {
+            // double process range array capacity
+            programPtr->processCapacity *= 2;
+            programPtr->processes = (ProcessRangeType *) realloc(programPtr->processes,
+                                                                 programPtr->processCapacity * sizeof(ProcessRangeType));
+        }
+        // open new process range at this op, end index is set when app end is found
+        rangePtr = &programPtr->processes[programPtr->processCount];
+        rangePtr->startIndex = programPtr->opCount;
+        rangePtr->endIndex = BAD_ARG_VAL;
+        programPtr->processCount++;
+    }
+    // check for op command inside an open process range
+    if (programPtr->processCount > 0 && programPtr->processes[programPtr->processCount - 1].endIndex == BAD_ARG_VAL
+        && localPtr->commandCode != CMD_SYS) {
+        // assign process id to op command
+        localPtr->pid = programPtr->processCount - 1;
+        // check for app end op command
+        if (localPtr->commandCode == CMD_APP && localPtr->argCode == ARG_END) {
+            // close process range at this op
+            programPtr->processes[programPtr->processCount - 1].endIndex = programPtr->opCount;
+        }
+    }
+    // increment op count
+    programPtr->opCount++;
+}
 
-        localPtr->nextNode = NULL;
-        // return current local pointer
-        return localPtr;
-    }
-    // assume end of list not found yet
-    localPtr->nextNode = addNode(localPtr->nextNode, newNode);
-    // assign recursive function to current's next link
-    return localPtr;
+/*
+ * Function Name: hashKeyword
+ * Algorithm: combines the first two characters, the last character and the length of the keyword into a keyword
+ *      table slot; the factors are chosen so every op code keyword gets its own slot
+ * Precondition: keyword is a C-style string with at least two characters
+ * Postcondition: returns keyword table slot
+ * Exceptions: none
+ * Notes: none
+ */
+int hashKeyword(char *keyword, int length) {
+    // return slot for the keyword
+    return (3 * keyword[0] + 8 * keyword[1] + keyword[length - 1] + length) & (KEYWORD_TABLE_SIZE - 1);
 }
 
 /*
- * Function Name: getCommand
- * Algorithm: gets first three letters of input string to get command
- * Precondition: provided starting index
- * Postcondition: returns command (ref param) and updated index (return)
+ * Function Name: getKeywordCode
+ * Algorithm: looks up keyword in the perfect hash keyword table, confirms it with a single string compare
+ * Precondition: input string is provided
+ * Postcondition: returns command, in/out or first string argument code for the keyword if it belongs to the
+ *      requested keyword class, BAD_ARG_VAL otherwise
  * Exceptions: none
  * Notes: none
  */
-int getCommand(char *cmd, char *inputStr, int index) {
+int getKeywordCode(char *keyword, KeywordClass keywordClass) {
     // init variables
-    int lengthOfCommand = 3;
-    // loop across command length
-    while(index < lengthOfCommand) {
-        // assign character from input string to buffer string
-        cmd[index] = inputStr[index];
-        // increment index
-        index++;
-        // set next character to null character
-        cmd[index] = NULL_CHAR;
-    }
-    // return current index
-    return index;
+    int length = getStringLength(keyword);
+    const KeywordType *entry;
+    // check for string too short to be a keyword
+    if (length < 2) {
+        // return not found
+        return BAD_ARG_VAL;
+    }
+    // find keyword table slot
+    entry = &KEYWORD_TABLE[hashKeyword(keyword, length)];
+    // check for keyword in slot
+    if (entry->name != NULL && entry->keywordClass == keywordClass && compareString(keyword, entry->name) == STR_EQ) {
+        // return keyword code
+        return entry->code;
+    }
+    // return not found
+    return BAD_ARG_VAL;
 }
 
 /*
- * Function Name: verifyValidCommand
- * Algorithm: check string argument for one of the allowed commands
- * Precondition: input string is provided
- * Postcondition: in correct operation, reports if given string is a command, False if not
+ * Function Name: getCommandName
+ * Algorithm: looks up display name of op command code
+ * Precondition: command code is an OpCommandCode value
+ * Postcondition: returns op command string
  * Exceptions: none
  * Notes: none
  */
-Boolean verifyValidCommand(char *testCmd) {
-    // check for five string command arguments
-    if (compareString(testCmd, "sys") == STR_EQ
-        || compareString(testCmd, "app") == STR_EQ
-        || compareString(testCmd, "cpu") == STR_EQ
-        || compareString(testCmd, "mem") == STR_EQ
-        || compareString(testCmd, "dev") == STR_EQ) {
-        // return True
-        return True;
-    }
-    // return False
-    return False;
+char *getCommandName(int commandCode) {
+    // return command name
+    return COMMAND_NAMES[commandCode];
 }
 
 /*
- * Function Name: getStringArg
- * Algorithm: skips leading white space, acquires sub string from op command input string ending at command or end of string
- * Precondition: input string has some remaining string argument
- * Postcondition: in correct operationg, captures next string argument
+ * Function Name: getInOutName
+ * Algorithm: looks up display name of device in/out code
+ * Precondition: in/out code is an OpInOutCode value
+ * Postcondition: returns in/out string, empty for non-device op commands
  * Exceptions: none
- * Notes nonel
+ * Notes: none
  */
-int getStringArg(char *strArg, char *inputStr, int index) {
-    // init variables
-    int localIndex = 0;
-    // loop to skip white space and comma
-    while (inputStr[index] <= SPACE || inputStr[index] == COMMA) {
-        // increment index
-        index++;
-    }
-    // loop across string length
-    while(inputStr[index] != COMMA && inputStr[index] != NULL_CHAR) {
-        // assign character from input string to buffer string
-        strArg[localIndex] = inputStr[index];
-        // increment index
-        index++;
-        localIndex++;
-        // set next character to null character
-        strArg[localIndex] = NULL_CHAR;
-    }
-    // end loop across string length
-    // return current index
-    return index;
+char *getInOutName(int inOutCode) {
+    // return in/out name
+    return IN_OUT_NAMES[inOutCode];
 }
 
 /*
- * Function Name: verifyFirstStringArg
- * Algorithm: check string argument for one of the allowed string arguments
- * Precondition: input string is provided
- * Postcondition: in correct operation, reports True if given string is in argument list, False if not
+ * Function Name: getArgName
+ * Algorithm: looks up display name of first string argument code
+ * Precondition: arg code is an OpArgCode value
+ * Postcondition: returns first string argument string
  * Exceptions: none
  * Notes: none
  */
-Boolean verifyFirstStringArg(char *strArg) {
-    // check for all possible string arg 1 possibilities
-    if (compareString(strArg, "access") == STR_EQ
-        || compareString(strArg, "allocate") == STR_EQ
-        || compareString(strArg, "end") == STR_EQ
-        || compareString(strArg, "ethernet") == STR_EQ
-        || compareString(strArg, "hard drive") == STR_EQ
-        || compareString(strArg, "keyboard") == STR_EQ
-        || compareString(strArg, "monitor") == STR_EQ
-        || compareString(strArg, "printer") == STR_EQ
-        || compareString(strArg, "process") == STR_EQ
-        || compareString(strArg, "serial") == STR_EQ
-        || compareString(strArg, "sound signal") == STR_EQ
-        || compareString(strArg, "start") == STR_EQ
-        || compareString(strArg, "usb") == STR_EQ
-        || compareString(strArg, "video signal") == STR_EQ) {
-        // return True
-        return True;
-    }
-    // return False
-    return False;
+char *getArgName(int argCode) {
+    // return argument name
+    return ARG_NAMES[argCode];
 }
 
 /*
- * Function Name: getNumberArg
- * Algorithm: skips leading white space, acquires next integer from op command input string ending at command or end
- *      of string
- * Precondition: input string has some remaining string argument
- * Postcondition: in correct operation, captures next integer argument, returns index location after process finished
+ * Function Name: verifyValidCommand
+ * Algorithm: check string argument for one of the allowed commands
+ * Precondition: input string is provided
+ * Postcondition: in correct operation, reports if given string is a command, False if not
  * Exceptions: none
  * Notes: none
  */
-int getNumberArg(int *number, char *inputStr, int index) {
-    // init variables
-    Boolean foundDigit = False;
-    *number = 0;
-    int multiplier = 10;
-    // loop to skip white space
-    while (inputStr[index] <= SPACE || inputStr[index] == COMMA) {
-        // increment index
-        index++;
-    }
-    // loop across string length
-    while(isDigit(inputStr[index]) == True && inputStr[index] != NULL_CHAR) {
-        // set digit found flag
-        foundDigit = True;
-        // assign digit to output
-        (*number) = ((*number) * multiplier) + (inputStr[index] - '0');
-        // increment index
-        index++;
-    }
-    // end loop across string length
+Boolean verifyValidCommand(char *testCmd) {
+    // check keyword table for command
+    return getKeywordCode(testCmd, KEYWORD_COMMAND) != BAD_ARG_VAL;
+}
 
-    // check for digit not found
-    if (foundDigit == False) {
-        // set number to BAD_ARG_VAL constant
-        *number = BAD_ARG_VAL;
-    }
-    // return current index
-    return index;
+/*
+ * Function Name: verifyFirstStringArg
+ * Algorithm: check string argument for one of the allowed string arguments
+ * Precondition: input string is provided
+ * Postcondition: in correct operation, reports True if given string is in argument list, False if not
+ * Exceptions: none
+ * Notes: none
+ */
+Boolean verifyFirstStringArg(char *strArg) {
+    // check keyword table for first string argument
+    return getKeywordCode(strArg, KEYWORD_ARG) != BAD_ARG_VAL;
 }
 
 /*
@@ -17,21 +17,44 @@ typedef enum {
     LAST_OPCMD_FOUND_MSG
 } OpCodeMessages;
 
+// keyword classes for the keyword table
+typedef enum {
+    KEYWORD_COMMAND,
+    KEYWORD_IN_OUT,
+    KEYWORD_ARG
+} KeywordClass;
+
+// op command tokens, read in this order as each one completes
+typedef enum {
+    OP_TOKEN_COMMAND,
+    OP_TOKEN_WORD_START,
+    OP_TOKEN_WORD,
+    OP_TOKEN_NUMBER_START,
+    OP_TOKEN_NUMBER,
+    OP_TOKEN_REST
+} OpTokenState;
+
 extern const int BAD_ARG_VAL;
 
 // function prototypes
-OpCodeType *clearMetaDataList(OpCodeType *localPtr);
-void displayMetaData(OpCodeType *localPtr);
-Boolean getMetaData(char *fileName, OpCodeType **opCodeDataHead, char *endStateMsg);
-int getOpCommand(FILE *filePtr, OpCodeType *inData);
-int updateStartCount(int count, char *opString);
-int updateEndCount(int count, char *opString);
-OpCodeType *addNode(OpCodeType *localPtr, OpCodeType *newNode);
-int getCommand(char *cmd, char *inputStr, int index);
+OpProgramType *clearMetaData(OpProgramType *programPtr);
+OpProgramType *createOpProgram();
+void displayMetaData(OpProgramType *programPtr);
+Boolean getMetaData(char *fileName, OpProgramType **programPtr, char *endStateMsg);
+int getOpCommand(FileBufferType *filePtr, OpCodeType *inData);
+OpTokenState setOpCommandToken(OpCodeType *inData, char *cmd, int *opResult);
+OpTokenState setOpStringToken(OpCodeType *inData, char *strArg, int tokenLength, int bufferSize, int *opResult);
+OpTokenState setOpNumberToken(OpCodeType *inData, int number, Boolean foundDigit, int *numberCount, int *opResult);
+int updateStartCount(int count, int argCode);
+int updateEndCount(int count, int argCode);
+void addNode(OpProgramType *programPtr, OpCodeType *newNode);
+int hashKeyword(char *keyword, int length);
+int getKeywordCode(char *keyword, KeywordClass keywordClass);
+char *getCommandName(int commandCode);
+char *getInOutName(int inOutCode);
+char *getArgName(int argCode);
 Boolean verifyValidCommand(char *testCmd);
-int getStringArg(char *strArg, char *inputStr, int index);
 Boolean verifyFirstStringArg(char *strArg);
-int getNumberArg(int *number, char *inputStr, int index);
 Boolean isDigit(char testChar);
 
 #endif
@@ -0,0 +1,262 @@
+#include "metadatastream.h"
+
+const int STREAM_QUEUE_CAPACITY = 16;
+
+/**
+ * Create an empty process block
+ * @param pid id of the process the block belongs to
+ * @return new process block
+ */
+static ProcessBlockType *createProcessBlock(int pid) {
+    const int INITIAL_OP_CAPACITY = 16;
+    ProcessBlockType *block = calloc(1, sizeof(ProcessBlockType));
+    block->pid = pid;
+    block->ops = malloc(INITIAL_OP_CAPACITY * sizeof(OpCodeType));
+    block->opCapacity = INITIAL_OP_CAPACITY;
+    return block;
+}
+
+/**
+ * Free a process block and its op codes
+ * @param block process block, or NULL
+ * @return NULL
+ */
+ProcessBlockType *clearProcessBlock(ProcessBlockType *block) {
+    if (block != NULL) {
+        free(block->ops);
+        free(block);
+    }
+    return NULL;
+}
+
+/**
+ * Append an op code to a process block
+ * @param block process block
+ * @param op op code, copied into the block
+ */
+static void addBlockOp(ProcessBlockType *block, OpCodeType *op) {
+    if (block->opCount == block->opCapacity) {
+        block->opCapacity *= 2;
+        block->ops = realloc(block->ops, block->opCapacity * sizeof(OpCodeType));
+    }
+    block->ops[block->opCount] = *op;
+    block->ops[block->opCount].pid = block->pid;
+    block->opCount++;
+}
+
+/**
+ * Hand a complete process block to the simulator, waiting while the queue is full
+ * @param stream metadata stream
+ * @param block complete process block
+ * @return False if the simulator has stopped reading the stream
+ */
+static Boolean pushProcessBlock(MetaDataStreamType *stream, ProcessBlockType *block) {
+    pthread_mutex_lock(&stream->lock);
+    while (stream->queuedCount >= stream->capacity && stream->cancelled == False) {
+        pthread_cond_wait(&stream->spaceReady, &stream->lock);
+    }
+    if (stream->cancelled == True) {
+        pthread_mutex_unlock(&stream->lock);
+        clearProcessBlock(block);
+        return False;
+    }
+    if (stream->tail == NULL) {
+        stream->head = block;
+    } else {
+        stream->tail->next = block;
+    }
+    stream->tail = block;
+    stream->queuedCount++;
+    pthread_cond_signal(&stream->blockReady);
+    pthread_mutex_unlock(&stream->lock);
+    return True;
+}
+
+/**
+ * Mark the stream as fully parsed, the simulator gets no more blocks after the queued ones
+ * @param stream metadata stream
+ * @param returnState False if the metadata file was corrupt
+ * @param endStateMsg end state message
+ */
+static void finishMetaDataStream(MetaDataStreamType *stream, Boolean returnState, char *endStateMsg) {
+    pthread_mutex_lock(&stream->lock);
+    stream->returnState = returnState;
+    stream->endStateMsg = endStateMsg;
+    stream->finished = True;
+    pthread_cond_broadcast(&stream->blockReady);
+    pthread_mutex_unlock(&stream->lock);
+}
+
+/**
+ * Main method for the parser thread.
+ * Parses the op codes after the first one, releasing each process block once its app end has been seen.
+ * Start and end op codes are checked as they are parsed, the same counts getMetaData compares at the end.
+ */
+static void *metaDataStreamThread(void *args) {
+    MetaDataStreamType *stream = (MetaDataStreamType *) args;
+    OpCodeType newNode = stream->firstNode;
+    ProcessBlockType *block = NULL;
+    int accessResult = COMPLETE_OPCMD_FOUND_MSG;
+    int startCount = 0, endCount = 0, nextPid = 0;
+    char dataBuffer[MAX_STR_LEN];
+
+    while (accessResult == COMPLETE_OPCMD_FOUND_MSG) {
+        startCount = updateStartCount(startCount, newNode.argCode);
+        endCount = updateEndCount(endCount, newNode.argCode);
+
+        if (newNode.commandCode == CMD_APP && newNode.argCode == ARG_START) {
+            // processes can not be nested
+            if (block != NULL) {
+                accessResult = UNBALANCED_START_END_ERR;
+                break;
+            }
+            block = createProcessBlock(nextPid);
+            nextPid++;
+        }
+        // op codes outside of a process are not run
+        if (block != NULL) {
+            addBlockOp(block, &newNode);
+        }
+        if (newNode.commandCode == CMD_APP && newNode.argCode == ARG_END) {
+            if (block == NULL) {
+                accessResult = UNBALANCED_START_END_ERR;
+                break;
+            }
+            if (pushProcessBlock(stream, block) == False) {
+                block = NULL;
+                break;
+            }
+            block = NULL;
+        }
+        accessResult = getOpCommand(stream->filePtr, &newNode);
+    }
+    block = clearProcessBlock(block);
+
+    if (accessResult == LAST_OPCMD_FOUND_MSG) {
+        endCount = updateEndCount(endCount, newNode.argCode);
+        if (startCount != endCount) {
+            finishMetaDataStream(stream, False, "Metadata unbalanced start and end op codes");
+        } else if (getLineTo(stream->filePtr, MAX_STR_LEN, PERIOD, dataBuffer, IGNORE_LEADING_WS, True) != NO_ERR
+                   || compareString(dataBuffer, "End Program Meta-Data Code") != STR_EQ) {
+            finishMetaDataStream(stream, False, "Metadata corrupted descriptor error");
+        } else {
+            finishMetaDataStream(stream, True, "Metadata file upload successful");
+        }
+    } else if (accessResult == UNBALANCED_START_END_ERR) {
+        finishMetaDataStream(stream, False, "Metadata unbalanced start and end op codes");
+    } else if (accessResult == COMPLETE_OPCMD_FOUND_MSG) {
+        // the simulator stopped reading the stream
+        finishMetaDataStream(stream, True, "Metadata stream closed");
+    } else {
+        finishMetaDataStream(stream, False, "Corrupted metadata op code");
+    }
+    return NULL;
+}
+
+/**
+ * Open a metadata file and start parsing it in the background.
+ * The leader line and the first op code are checked before returning, so a missing or
+ * corrupt file is reported before the simulator starts.
+ * @param fileName metadata file name
+ * @param capacity number of parsed process blocks that may wait for the simulator
+ * @param endStateMsg end state message, set on failure
+ * @return new metadata stream, NULL on failure
+ */
+MetaDataStreamType *openMetaDataStream(char *fileName, int capacity, char *endStateMsg) {
+    char dataBuffer[MAX_STR_LEN];
+    FileBufferType *filePtr = openFileBuffer(fileName);
+
+    copyString(endStateMsg, "Metadata file upload successful");
+    if (filePtr == NULL) {
+        copyString(endStateMsg, "Metadata file access error");
+        return NULL;
+    }
+    if (getLineTo(filePtr, MAX_STR_LEN, COLON, dataBuffer, IGNORE_LEADING_WS, True) != NO_ERR
+        || compareString(dataBuffer, "Start Program Meta-Data Code") != STR_EQ) {
+        closeFileBuffer(filePtr);
+        copyString(endStateMsg, "Corrupt metadata leader line error");
+        return NULL;
+    }
+
+    MetaDataStreamType *stream = calloc(1, sizeof(MetaDataStreamType));
+    if (getOpCommand(filePtr, &stream->firstNode) != COMPLETE_OPCMD_FOUND_MSG) {
+        closeFileBuffer(filePtr);
+        free(stream);
+        copyString(endStateMsg, "Metadata incomplete first op command found");
+        return NULL;
+    }
+    stream->filePtr = filePtr;
+    stream->capacity = capacity < 1 ? 1 : capacity;
+    pthread_mutex_init(&stream->lock, NULL);
+    pthread_cond_init(&stream->blockReady, NULL);
+    pthread_cond_init(&stream->spaceReady, NULL);
+    pthread_create(&stream->thread, NULL, metaDataStreamThread, stream);
+    return stream;
+}
+
+/**
+ * Stop the parser thread, free any blocks the simulator did not take and close the file
+ * @param stream metadata stream, or NULL
+ * @return NULL
+ */
+MetaDataStreamType *closeMetaDataStream(MetaDataStreamType *stream) {
+    if (stream == NULL) {
+        return NULL;
+    }
+    pthread_mutex_lock(&stream->lock);
+    stream->cancelled = True;
+    pthread_cond_broadcast(&stream->spaceReady);
+    pthread_mutex_unlock(&stream->lock);
+    pthread_join(stream->thread, NULL);
+
+    while (stream->head != NULL) {
+        ProcessBlockType *nextBlock = stream->head->next;
+        clearProcessBlock(stream->head);
+        stream->head = nextBlock;
+    }
+    pthread_mutex_destroy(&stream->lock);
+    pthread_cond_destroy(&stream->blockReady);
+    pthread_cond_destroy(&stream->spaceReady);
+    closeFileBuffer(stream->filePtr);
+    free(stream);
+    return NULL;
+}
+
+/**
+ * Take the next process block, waiting for the parser if none is queued yet
+ * @param stream metadata stream
+ * @return next process block, NULL once the whole file has been parsed or parsing failed
+ */
+ProcessBlockType *takeProcessBlock(MetaDataStreamType *stream) {
+    pthread_mutex_lock(&stream->lock);
+    while (stream->head == NULL && stream->finished == False) {
+        pthread_cond_wait(&stream->blockReady, &stream->lock);
+    }
+    ProcessBlockType *block = stream->head;
+    if (block != NULL) {
+        stream->head = block->next;
+        if (stream->head == NULL) {
+            stream->tail = NULL;
+        }
+        block->next = NULL;
+        stream->queuedCount--;
+        pthread_cond_signal(&stream->spaceReady);
+    }
+    pthread_mutex_unlock(&stream->lock);
+    return block;
+}
+
+/**
+ * Get the outcome of parsing the stream
+ * @param stream metadata stream
+ * @param endStateMsg end state message
+ * @return False if the metadata file turned out to be corrupt
+ */
+Boolean getMetaDataStreamResult(MetaDataStreamType *stream, char *endStateMsg) {
+    pthread_mutex_lock(&stream->lock);
+    // a stream still being parsed has not failed so far
+    Boolean returnState = stream->finished == False || stream->returnState == True;
+    copyString(endStateMsg, stream->finished == True ? stream->endStateMsg : "Metadata file upload successful");
+    pthread_mutex_unlock(&stream->lock);
+    return returnState;
+}
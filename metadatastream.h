@@ -0,0 +1,50 @@
+#ifndef METADATASTREAM_H
+#define METADATASTREAM_H
+
+#include <pthread.h>
+#include "datatypes.h"
+#include "StringUtils.h"
+#include "metadataops.h"
+
+// GLOBAL CONSTANTS
+extern const int STREAM_QUEUE_CAPACITY;
+
+/**
+ * The op codes of one process, from its app start up to its app end
+ */
+typedef struct ProcessBlockType {
+    int pid;
+    OpCodeType *ops;
+    int opCount;
+    int opCapacity;
+    struct ProcessBlockType *next;
+} ProcessBlockType;
+
+/**
+ * Metadata file parsed by a background thread into a bounded queue of process blocks
+ */
+typedef struct MetaDataStreamType {
+    FileBufferType *filePtr;
+    OpCodeType firstNode;
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t blockReady;
+    pthread_cond_t spaceReady;
+    ProcessBlockType *head;
+    ProcessBlockType *tail;
+    int queuedCount;
+    int capacity;
+    Boolean finished;
+    Boolean cancelled;
+    Boolean returnState;
+    char *endStateMsg;
+} MetaDataStreamType;
+
+// function prototypes
+MetaDataStreamType *openMetaDataStream(char *fileName, int capacity, char *endStateMsg);
+MetaDataStreamType *closeMetaDataStream(MetaDataStreamType *stream);
+ProcessBlockType *takeProcessBlock(MetaDataStreamType *stream);
+ProcessBlockType *clearProcessBlock(ProcessBlockType *block);
+Boolean getMetaDataStreamResult(MetaDataStreamType *stream, char *endStateMsg);
+
+#endif
@@ -0,0 +1,380 @@
+#include "pagetable.h"
+
+const int PAGE_NO_FRAME = -1;
+
+/**
+ * Hash a page number to its home slot
+ * @param pages page table
+ * @param page page number
+ * @return home slot of the page
+ */
+static int getHomeSlot(PageTableType *pages, long long page) {
+    unsigned long long hash = (unsigned long long) page * 0x9E3779B97F4A7C15ULL;
+    return (int) (hash >> 32) & pages->slotMask;
+}
+
+/**
+ * Find the slot holding a page, or the empty slot it would go in
+ * @param pages page table
+ * @param page page number
+ * @return slot index
+ */
+static int findPageSlot(PageTableType *pages, long long page) {
+    int slot = getHomeSlot(pages, page);
+    while (pages->slots[slot] != PAGE_NO_FRAME && pages->frames[pages->slots[slot]].page != page) {
+        slot = (slot + 1) & pages->slotMask;
+    }
+    return slot;
+}
+
+/**
+ * Empty a slot, shifting back the pages that probed past it so every lookup still finds them
+ * @param pages page table
+ * @param slot slot to empty
+ */
+static void removePageSlot(PageTableType *pages, int slot) {
+    int hole = slot;
+    int next = (slot + 1) & pages->slotMask;
+    while (pages->slots[next] != PAGE_NO_FRAME) {
+        int home = getHomeSlot(pages, pages->frames[pages->slots[next]].page);
+        // a page can fill the hole if the hole lies between its home and its slot
+        if (((next - home) & pages->slotMask) >= ((next - hole) & pages->slotMask)) {
+            pages->slots[hole] = pages->slots[next];
+            hole = next;
+        }
+        next = (next + 1) & pages->slotMask;
+    }
+    pages->slots[hole] = PAGE_NO_FRAME;
+}
+
+/**
+ * Unlink a frame from the load/use order
+ * @param pages page table
+ * @param frame frame index
+ */
+static void unlinkFrame(PageTableType *pages, int frame) {
+    PageFrameType *entry = &pages->frames[frame];
+    if (entry->newer != PAGE_NO_FRAME) {
+        pages->frames[entry->newer].older = entry->older;
+    } else {
+        pages->newestFrame = entry->older;
+    }
+    if (entry->older != PAGE_NO_FRAME) {
+        pages->frames[entry->older].newer = entry->newer;
+    } else {
+        pages->oldestFrame = entry->newer;
+    }
+}
+
+/**
+ * Link a frame in as the newest of the load/use order
+ * @param pages page table
+ * @param frame frame index
+ */
+static void linkNewestFrame(PageTableType *pages, int frame) {
+    PageFrameType *entry = &pages->frames[frame];
+    entry->newer = PAGE_NO_FRAME;
+    entry->older = pages->newestFrame;
+    if (pages->newestFrame != PAGE_NO_FRAME) {
+        pages->frames[pages->newestFrame].newer = frame;
+    } else {
+        pages->oldestFrame = frame;
+    }
+    pages->newestFrame = frame;
+}
+
+/**
+ * Look a page up in the TLB
+ * @param pages page table
+ * @param page page number
+ * @return frame of the page, PAGE_NO_FRAME on a miss
+ */
+static int lookupTlb(PageTableType *pages, long long page) {
+    TlbEntryType *set = pages->tlb[page & (TLB_SET_COUNT - 1)];
+    for (int way = 0; way < TLB_WAY_COUNT; way++) {
+        if (set[way].page == page) {
+            set[way].lastUse = ++pages->tlbClock;
+            return set[way].frame;
+        }
+    }
+    return PAGE_NO_FRAME;
+}
+
+/**
+ * Cache a translation in the TLB, replacing the least recently used entry of its set
+ * @param pages page table
+ * @param page page number
+ * @param frame frame of the page
+ */
+static void fillTlb(PageTableType *pages, long long page, int frame) {
+    TlbEntryType *set = pages->tlb[page & (TLB_SET_COUNT - 1)];
+    TlbEntryType *victim = &set[0];
+    for (int way = 1; way < TLB_WAY_COUNT && victim->page >= 0; way++) {
+        if (set[way].page < 0 || set[way].lastUse < victim->lastUse) {
+            victim = &set[way];
+        }
+    }
+    victim->page = page;
+    victim->frame = frame;
+    victim->lastUse = ++pages->tlbClock;
+}
+
+/**
+ * Drop the translation of a page that left memory
+ * @param pages page table
+ * @param page page number
+ */
+static void invalidateTlb(PageTableType *pages, long long page) {
+    TlbEntryType *set = pages->tlb[page & (TLB_SET_COUNT - 1)];
+    for (int way = 0; way < TLB_WAY_COUNT; way++) {
+        if (set[way].page == page) {
+            set[way].page = -1;
+        }
+    }
+}
+
+/**
+ * Take a resident page out of memory, leaving its frame unlinked
+ * @param pages page table
+ * @param slot slot of the page
+ * @return frame the page was in
+ */
+static int unloadPage(PageTableType *pages, int slot) {
+    int frame = pages->slots[slot];
+    invalidateTlb(pages, pages->frames[frame].page);
+    removePageSlot(pages, slot);
+    unlinkFrame(pages, frame);
+    pages->frames[frame].page = -1;
+    pages->frames[frame].referenced = False;
+    return frame;
+}
+
+/**
+ * Pick the frame to evict when every frame is in use
+ * @param pages page table
+ * @return victim frame
+ */
+static int chooseVictimFrame(PageTableType *pages) {
+    if (pages->replaceCode != PAGE_REPLACE_CLOCK_CODE) {
+        // FIFO keeps frames in load order and LRU in use order, the oldest goes either way
+        return pages->oldestFrame;
+    }
+    // the hand gives every referenced frame a second chance
+    while (True) {
+        int frame = pages->clockHand;
+        pages->clockHand = (pages->clockHand + 1) % pages->frameCount;
+        if (pages->frames[frame].referenced == False) {
+            return frame;
+        }
+        pages->frames[frame].referenced = False;
+    }
+}
+
+/**
+ * Load a page into a free frame, evicting a page if there is none
+ * @param pages page table
+ * @param page page number
+ * @param slot empty slot the page goes in
+ * @return frame the page was loaded into
+ */
+static int loadPage(PageTableType *pages, long long page, int slot) {
+    int frame;
+    if (pages->freeFrameCount > 0) {
+        frame = pages->freeFrames[--pages->freeFrameCount];
+    } else {
+        frame = unloadPage(pages, findPageSlot(pages, pages->frames[chooseVictimFrame(pages)].page));
+        pages->evictionCount++;
+        // the eviction may have shifted the empty slot
+        slot = findPageSlot(pages, page);
+    }
+    pages->frames[frame].page = page;
+    pages->frames[frame].referenced = True;
+    linkNewestFrame(pages, frame);
+    pages->slots[slot] = frame;
+    return frame;
+}
+
+/**
+ * Get the paging counters of a process, growing the table as needed
+ * @param pages page table
+ * @param pid process id
+ * @return counters of the process
+ */
+static PageStatsType *getProcessStats(PageTableType *pages, int pid) {
+    if (pid >= pages->processStatsSize) {
+        int newSize = pages->processStatsSize * 2;
+        while (newSize <= pid) {
+            newSize *= 2;
+        }
+        pages->processStats = realloc(pages->processStats, newSize * sizeof(PageStatsType));
+        for (int index = pages->processStatsSize; index < newSize; index++) {
+            pages->processStats[index] = (PageStatsType) {0, 0, 0};
+        }
+        pages->processStatsSize = newSize;
+    }
+    return &pages->processStats[pid];
+}
+
+/**
+ * Create a page table with every frame free
+ * @param replaceCode page replacement policy, a PAGE_REPLACE code
+ * @param pageSize size of a page in KB
+ * @param memAvailable size of memory in KB, cut into frames
+ * @return new page table
+ */
+PageTableType *createPageTable(int replaceCode, int pageSize, int memAvailable) {
+    PageTableType *pages = calloc(1, sizeof(PageTableType));
+    pages->replaceCode = replaceCode;
+    pages->pageSize = pageSize;
+    pages->frameCount = memAvailable / pageSize > 0 ? memAvailable / pageSize : 1;
+    pages->frames = malloc(pages->frameCount * sizeof(PageFrameType));
+    pages->freeFrames = malloc(pages->frameCount * sizeof(int));
+    pages->newestFrame = PAGE_NO_FRAME;
+    pages->oldestFrame = PAGE_NO_FRAME;
+    // hand out low frames first
+    for (int frame = 0; frame < pages->frameCount; frame++) {
+        pages->frames[frame].page = -1;
+        pages->frames[frame].referenced = False;
+        pages->freeFrames[pages->frameCount - 1 - frame] = frame;
+    }
+    pages->freeFrameCount = pages->frameCount;
+
+    // keep the hash at most half full
+    int slotCount = 2;
+    while (slotCount < 2 * pages->frameCount) {
+        slotCount *= 2;
+    }
+    pages->slots = malloc(slotCount * sizeof(int));
+    for (int slot = 0; slot < slotCount; slot++) {
+        pages->slots[slot] = PAGE_NO_FRAME;
+    }
+    pages->slotMask = slotCount - 1;
+
+    for (int set = 0; set < TLB_SET_COUNT; set++) {
+        for (int way = 0; way < TLB_WAY_COUNT; way++) {
+            pages->tlb[set][way].page = -1;
+        }
+    }
+    pages->processStatsSize = 16;
+    pages->processStats = calloc(pages->processStatsSize, sizeof(PageStatsType));
+    return pages;
+}
+
+/**
+ * Free a page table
+ * @param pages page table, or NULL
+ * @return NULL
+ */
+PageTableType *clearPageTable(PageTableType *pages) {
+    if (pages != NULL) {
+        free(pages->frames);
+        free(pages->freeFrames);
+        free(pages->slots);
+        free(pages->processStats);
+        free(pages);
+    }
+    return NULL;
+}
+
+/**
+ * Touch every page of a memory access, loading the pages that are not resident
+ * @param pages page table
+ * @param pid process making the access
+ * @param base first address accessed
+ * @param size size of the access, positive
+ * @return number of page faults
+ */
+int accessPages(PageTableType *pages, int pid, long long base, long long size) {
+    PageStatsType *stats = getProcessStats(pages, pid);
+    long long lastPage = (base + size - 1) / pages->pageSize;
+    int faultCount = 0;
+    int hitCount = 0;
+
+    for (long long page = base / pages->pageSize; page <= lastPage; page++) {
+        int frame = lookupTlb(pages, page);
+        if (frame != PAGE_NO_FRAME) {
+            hitCount++;
+        } else {
+            int slot = findPageSlot(pages, page);
+            frame = pages->slots[slot];
+            if (frame == PAGE_NO_FRAME) {
+                frame = loadPage(pages, page, slot);
+                faultCount++;
+            }
+            fillTlb(pages, page, frame);
+        }
+        pages->frames[frame].referenced = True;
+        if (pages->replaceCode == PAGE_REPLACE_LRU_CODE && pages->newestFrame != frame) {
+            unlinkFrame(pages, frame);
+            linkNewestFrame(pages, frame);
+        }
+    }
+    long long accessCount = lastPage - base / pages->pageSize + 1;
+    stats->accessCount += accessCount;
+    stats->tlbHitCount += hitCount;
+    stats->faultCount += faultCount;
+    pages->total.accessCount += accessCount;
+    pages->total.tlbHitCount += hitCount;
+    pages->total.faultCount += faultCount;
+    return faultCount;
+}
+
+/**
+ * Free the frames of every resident page a freed segment covers
+ * @param pages page table
+ * @param base first address of the segment
+ * @param end address after the segment
+ */
+void releasePages(PageTableType *pages, long long base, long long end) {
+    long long lastPage = (end - 1) / pages->pageSize;
+    for (long long page = base / pages->pageSize; page <= lastPage; page++) {
+        int slot = findPageSlot(pages, page);
+        if (pages->slots[slot] != PAGE_NO_FRAME) {
+            pages->freeFrames[pages->freeFrameCount++] = unloadPage(pages, slot);
+        }
+    }
+}
+
+/**
+ * Display the TLB hit rate and page faults of a run, in total and for each process
+ * @param pages page table, or NULL when paging is off
+ */
+void displayPageTable(PageTableType *pages) {
+    if (pages == NULL) {
+        return;
+    }
+    char displayString[STD_STR_LEN];
+    int processCount = 0;
+    int maxPid = 0;
+    for (int pid = 0; pid < pages->processStatsSize; pid++) {
+        PageStatsType *stats = &pages->processStats[pid];
+        if (stats->accessCount > 0) {
+            processCount++;
+        }
+        if (stats->faultCount > pages->processStats[maxPid].faultCount) {
+            maxPid = pid;
+        }
+    }
+    long long accessCount = pages->total.accessCount;
+    long long hitCount = pages->total.tlbHitCount;
+
+    configCodeToString(pages->replaceCode, displayString);
+    printf("Paging: %s, %d KB pages, %d frames, TLB hit rate %.2f%% over %lld page accesses\n",
+           displayString, pages->pageSize, pages->frameCount,
+           accessCount > 0 ? 100.0 * hitCount / accessCount : 0.0, accessCount);
+    printf("Page faults: %lld, %lld evictions, mean %.2f per process, max %lld for process %d\n",
+           pages->total.faultCount, pages->evictionCount,
+           processCount > 0 ? (double) pages->total.faultCount / processCount : 0.0,
+           pages->processStats[maxPid].faultCount, maxPid);
+    // one row for every process that touched memory
+    if (processCount > 0) {
+        printf("%-8s %12s %12s %10s %12s\n", "process", "accesses", "TLB hits", "hit rate", "faults");
+    }
+    for (int pid = 0; pid < pages->processStatsSize; pid++) {
+        PageStatsType *stats = &pages->processStats[pid];
+        if (stats->accessCount > 0) {
+            printf("%-8d %12lld %12lld %9.2f%% %12lld\n", pid, stats->accessCount, stats->tlbHitCount,
+                   100.0 * stats->tlbHitCount / stats->accessCount, stats->faultCount);
+        }
+    }
+}
@@ -0,0 +1,75 @@
+#ifndef PAGETABLE_H
+#define PAGETABLE_H
+
+#include "datatypes.h"
+#include "configops.h"
+
+// GLOBAL CONSTANTS
+extern const int PAGE_NO_FRAME;
+
+// the TLB is set associative, a page can only sit in the set its number maps to
+#define TLB_SET_COUNT 16
+#define TLB_WAY_COUNT 4
+
+/**
+ * A physical page frame, linked into the load order for FIFO or the use order for LRU
+ */
+typedef struct PageFrameType {
+    long long page;
+    Boolean referenced;
+    int newer;
+    int older;
+} PageFrameType;
+
+/**
+ * A cached translation, page is negative while the entry is empty
+ */
+typedef struct TlbEntryType {
+    long long page;
+    int frame;
+    long long lastUse;
+} TlbEntryType;
+
+/**
+ * Paging counters of one process
+ */
+typedef struct PageStatsType {
+    long long accessCount;
+    long long tlbHitCount;
+    long long faultCount;
+} PageStatsType;
+
+/**
+ * Demand paging of the memAvailable pool. Resident pages are found through an open addressing
+ * hash of page numbers to frames, so the table only grows with the number of frames.
+ */
+typedef struct PageTableType {
+    int replaceCode;
+    int pageSize;
+    int frameCount;
+    PageFrameType *frames;
+    int *freeFrames;
+    int freeFrameCount;
+    int newestFrame;
+    int oldestFrame;
+    int clockHand;
+    // resident pages, each slot holds a frame or PAGE_NO_FRAME
+    int *slots;
+    int slotMask;
+    TlbEntryType tlb[TLB_SET_COUNT][TLB_WAY_COUNT];
+    long long tlbClock;
+    // paging metrics
+    PageStatsType total;
+    long long evictionCount;
+    PageStatsType *processStats;
+    int processStatsSize;
+} PageTableType;
+
+// function prototypes
+PageTableType *createPageTable(int replaceCode, int pageSize, int memAvailable);
+PageTableType *clearPageTable(PageTableType *pages);
+int accessPages(PageTableType *pages, int pid, long long base, long long size);
+void releasePages(PageTableType *pages, long long base, long long end);
+void displayPageTable(PageTableType *pages);
+
+#endif
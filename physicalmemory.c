@@ -0,0 +1,402 @@
+#include "physicalmemory.h"
+#include "simclock.h"
+
+const int PHYSICAL_NO_BLOCK = -1;
+
+/**
+ * Get the power of two at or below a length
+ * @param length positive length
+ * @return floor of log2 of the length
+ */
+static int floorLog2(int length) {
+    return 31 - __builtin_clz((unsigned int) length);
+}
+
+/**
+ * Get the power of two at or above a length
+ * @param length positive length
+ * @return ceiling of log2 of the length
+ */
+static int ceilLog2(int length) {
+    return length <= 1 ? 0 : floorLog2(length - 1) + 1;
+}
+
+/**
+ * Allocate a cleared bitmap
+ * @param bitCount number of bits
+ * @return new bitmap
+ */
+static unsigned long long *createBitmap(long long bitCount) {
+    return calloc((size_t) ((bitCount + 63) / 64), sizeof(unsigned long long));
+}
+
+/**
+ * Check a bit of a bitmap
+ * @param bitmap bitmap
+ * @param index bit index
+ * @return True if the bit is set
+ */
+static Boolean testBit(unsigned long long *bitmap, long long index) {
+    return (bitmap[index / 64] >> (index % 64)) & 1ULL ? True : False;
+}
+
+/**
+ * Set or clear a run of bits of a bitmap, a whole word at a time where it can
+ * @param bitmap bitmap
+ * @param index first bit
+ * @param count number of bits
+ * @param value True to set the bits, False to clear them
+ */
+static void setBits(unsigned long long *bitmap, long long index, long long count, Boolean value) {
+    while (count > 0) {
+        long long bit = index % 64;
+        long long run = 64 - bit < count ? 64 - bit : count;
+        unsigned long long mask = run == 64 ? ~0ULL : ((1ULL << run) - 1) << bit;
+        if (value == True) {
+            bitmap[index / 64] |= mask;
+        } else {
+            bitmap[index / 64] &= ~mask;
+        }
+        index += run;
+        count -= run;
+    }
+}
+
+/**
+ * Mark a buddy block free at its order
+ * @param physical physical memory
+ * @param base first unit of the block
+ * @param order log2 of the block size
+ */
+static void addBuddyBlock(PhysicalMemoryType *physical, int base, int order) {
+    setBits(physical->freeBitmaps[order], base >> order, 1, True);
+    physical->freeCounts[order]++;
+}
+
+/**
+ * Take a buddy block off the free bitmap of its order
+ * @param physical physical memory
+ * @param base first unit of the block
+ * @param order log2 of the block size
+ */
+static void removeBuddyBlock(PhysicalMemoryType *physical, int base, int order) {
+    setBits(physical->freeBitmaps[order], base >> order, 1, False);
+    physical->freeCounts[order]--;
+}
+
+/**
+ * Allocate a buddy block, splitting a larger block when no block of the right order is free
+ * @param physical physical memory
+ * @param order log2 of the block size
+ * @return first unit of the block, PHYSICAL_NO_BLOCK if no block is large enough
+ */
+static int allocateBuddy(PhysicalMemoryType *physical, int order) {
+    int freeOrder = order;
+    while (freeOrder <= physical->maxOrder && physical->freeCounts[freeOrder] == 0) {
+        freeOrder++;
+    }
+    if (freeOrder > physical->maxOrder) {
+        return PHYSICAL_NO_BLOCK;
+    }
+
+    // find the first free block of that order a word at a time
+    unsigned long long *bitmap = physical->freeBitmaps[freeOrder];
+    int wordIndex = 0;
+    while (bitmap[wordIndex] == 0) {
+        wordIndex++;
+    }
+    int base = (wordIndex * 64 + __builtin_ctzll(bitmap[wordIndex])) << freeOrder;
+    removeBuddyBlock(physical, base, freeOrder);
+
+    // hand the upper halves back as the block is split down to size
+    while (freeOrder > order) {
+        freeOrder--;
+        addBuddyBlock(physical, base + (1 << freeOrder), freeOrder);
+    }
+    return base;
+}
+
+/**
+ * Free a buddy block, merging it with its buddy for as long as the buddy is free
+ * @param physical physical memory
+ * @param base first unit of the block
+ * @param order log2 of the block size
+ */
+static void releaseBuddy(PhysicalMemoryType *physical, int base, int order) {
+    while (order < physical->maxOrder) {
+        int buddyBase = base ^ (1 << order);
+        if (testBit(physical->freeBitmaps[order], buddyBase >> order) == False) {
+            break;
+        }
+        removeBuddyBlock(physical, buddyBase, order);
+        base = base < buddyBase ? base : buddyBase;
+        order++;
+    }
+    addBuddyBlock(physical, base, order);
+}
+
+/**
+ * Add a free extent to the bin of its size class and tag both of its ends with its length
+ * @param physical physical memory
+ * @param base first unit of the extent
+ * @param length length of the extent
+ */
+static void addExtent(PhysicalMemoryType *physical, int base, int length) {
+    int sizeClass = floorLog2(length);
+    physical->extentTags[base] = length;
+    physical->extentTags[base + length - 1] = length;
+    physical->binPrev[base] = PHYSICAL_NO_BLOCK;
+    physical->binNext[base] = physical->binHeads[sizeClass];
+    if (physical->binHeads[sizeClass] != PHYSICAL_NO_BLOCK) {
+        physical->binPrev[physical->binHeads[sizeClass]] = base;
+    }
+    physical->binHeads[sizeClass] = base;
+    physical->binMap |= 1U << sizeClass;
+}
+
+/**
+ * Take a free extent out of its bin
+ * @param physical physical memory
+ * @param base first unit of the extent
+ */
+static void removeExtent(PhysicalMemoryType *physical, int base) {
+    int sizeClass = floorLog2(physical->extentTags[base]);
+    if (physical->binPrev[base] == PHYSICAL_NO_BLOCK) {
+        physical->binHeads[sizeClass] = physical->binNext[base];
+    } else {
+        physical->binNext[physical->binPrev[base]] = physical->binNext[base];
+    }
+    if (physical->binNext[base] != PHYSICAL_NO_BLOCK) {
+        physical->binPrev[physical->binNext[base]] = physical->binPrev[base];
+    }
+    if (physical->binHeads[sizeClass] == PHYSICAL_NO_BLOCK) {
+        physical->binMap &= ~(1U << sizeClass);
+    }
+}
+
+/**
+ * Allocate an extent of exactly the requested length.
+ * Any extent in a size class above the request fits, so those are taken first without searching,
+ * only the request's own size class has to be searched for an extent that is long enough.
+ * @param physical physical memory
+ * @param length requested length
+ * @return first unit of the extent, PHYSICAL_NO_BLOCK if no free extent is long enough
+ */
+static int allocateSegregated(PhysicalMemoryType *physical, int length) {
+    int sizeClass = floorLog2(length);
+    unsigned int largerBins = sizeClass + 1 < PHYSICAL_CLASS_COUNT ? physical->binMap >> (sizeClass + 1) : 0;
+    int base = PHYSICAL_NO_BLOCK;
+
+    if (largerBins != 0) {
+        base = physical->binHeads[sizeClass + 1 + __builtin_ctz(largerBins)];
+    } else {
+        int extent = physical->binHeads[sizeClass];
+        while (extent != PHYSICAL_NO_BLOCK && physical->extentTags[extent] < length) {
+            extent = physical->binNext[extent];
+        }
+        base = extent;
+    }
+    if (base == PHYSICAL_NO_BLOCK) {
+        return PHYSICAL_NO_BLOCK;
+    }
+
+    // split the rest of the extent off as a free extent of its own
+    int extentLength = physical->extentTags[base];
+    removeExtent(physical, base);
+    if (extentLength > length) {
+        addExtent(physical, base + length, extentLength - length);
+    }
+    setBits(physical->usedBitmap, base, length, True);
+    return base;
+}
+
+/**
+ * Free an extent, merging it with the free extents on either side of it
+ * @param physical physical memory
+ * @param base first unit of the extent
+ * @param length length of the extent
+ */
+static void releaseSegregated(PhysicalMemoryType *physical, int base, int length) {
+    setBits(physical->usedBitmap, base, length, False);
+
+    // a free unit to the left is the last unit of a free extent, tagged with its length
+    if (base > 0 && testBit(physical->usedBitmap, base - 1) == False) {
+        int leftLength = physical->extentTags[base - 1];
+        base -= leftLength;
+        length += leftLength;
+        removeExtent(physical, base);
+    }
+    // a free unit to the right is the first unit of a free extent
+    if (base + length < physical->size && testBit(physical->usedBitmap, base + length) == False) {
+        int rightBase = base + length;
+        length += physical->extentTags[rightBase];
+        removeExtent(physical, rightBase);
+    }
+    addExtent(physical, base, length);
+}
+
+/**
+ * Get the largest block that could be allocated right now
+ * @param physical physical memory
+ * @return length of the largest free block
+ */
+static int getLargestFree(PhysicalMemoryType *physical) {
+    if (physical->allocCode == MEM_ALLOC_BUDDY_CODE) {
+        for (int order = physical->maxOrder; order >= 0; order--) {
+            if (physical->freeCounts[order] > 0) {
+                return 1 << order;
+            }
+        }
+        return 0;
+    }
+    if (physical->binMap == 0) {
+        return 0;
+    }
+    int largest = 0;
+    for (int extent = physical->binHeads[floorLog2((int) physical->binMap)]; extent != PHYSICAL_NO_BLOCK;
+         extent = physical->binNext[extent]) {
+        if (physical->extentTags[extent] > largest) {
+            largest = physical->extentTags[extent];
+        }
+    }
+    return largest;
+}
+
+/**
+ * Create a physical allocator with the whole pool free
+ * @param allocCode MEM_ALLOC_BUDDY_CODE or MEM_ALLOC_SEGREGATED_CODE
+ * @param size pool size in units
+ * @return new physical memory, NULL if the pool is empty
+ */
+PhysicalMemoryType *createPhysicalMemory(int allocCode, int size) {
+    if (size <= 0) {
+        return NULL;
+    }
+    PhysicalMemoryType *physical = calloc(1, sizeof(PhysicalMemoryType));
+    physical->allocCode = allocCode;
+    physical->size = size;
+    physical->freeUnits = size;
+
+    if (allocCode == MEM_ALLOC_BUDDY_CODE) {
+        // the buddy tree spans the next power of two, the part past the pool is never free
+        physical->maxOrder = ceilLog2(size);
+        for (int order = 0; order <= physical->maxOrder; order++) {
+            physical->freeBitmaps[order] = createBitmap((1LL << physical->maxOrder) >> order);
+        }
+        int base = 0;
+        while (base < size) {
+            int order = base == 0 ? physical->maxOrder : __builtin_ctz((unsigned int) base);
+            while (base + (1 << order) > size) {
+                order--;
+            }
+            addBuddyBlock(physical, base, order);
+            base += 1 << order;
+        }
+    } else {
+        physical->usedBitmap = createBitmap(size);
+        physical->extentTags = malloc(size * sizeof(int));
+        physical->binNext = malloc(size * sizeof(int));
+        physical->binPrev = malloc(size * sizeof(int));
+        for (int sizeClass = 0; sizeClass < PHYSICAL_CLASS_COUNT; sizeClass++) {
+            physical->binHeads[sizeClass] = PHYSICAL_NO_BLOCK;
+        }
+        addExtent(physical, 0, size);
+    }
+    return physical;
+}
+
+/**
+ * Free a physical allocator
+ * @param physical physical memory, or NULL
+ * @return NULL
+ */
+PhysicalMemoryType *clearPhysicalMemory(PhysicalMemoryType *physical) {
+    if (physical != NULL) {
+        for (int order = 0; order < PHYSICAL_CLASS_COUNT; order++) {
+            free(physical->freeBitmaps[order]);
+        }
+        free(physical->usedBitmap);
+        free(physical->extentTags);
+        free(physical->binNext);
+        free(physical->binPrev);
+        free(physical);
+    }
+    return NULL;
+}
+
+/**
+ * Allocate physical memory for a segment
+ * @param physical physical memory
+ * @param size requested size in units
+ * @param blockSize output for the size of the block actually taken, a buddy block rounds the request up
+ * @return first unit of the block, PHYSICAL_NO_BLOCK if the request can not be met
+ */
+int allocatePhysical(PhysicalMemoryType *physical, int size, int *blockSize) {
+    int base = PHYSICAL_NO_BLOCK;
+
+    // external fragmentation is sampled as each request arrives, before the allocation is timed
+    if (physical->freeUnits > 0) {
+        physical->externalFragmentationSum += 1.0 - (double) getLargestFree(physical) / physical->freeUnits;
+    }
+    physical->requestCount++;
+
+    long long startTime = getMonotonicNanoTime();
+
+    if (size > 0 && size <= physical->size) {
+        if (physical->allocCode == MEM_ALLOC_BUDDY_CODE) {
+            *blockSize = 1 << ceilLog2(size);
+            base = allocateBuddy(physical, ceilLog2(size));
+        } else {
+            *blockSize = size;
+            base = allocateSegregated(physical, size);
+        }
+    }
+    if (base == PHYSICAL_NO_BLOCK) {
+        physical->failureCount++;
+    } else {
+        physical->freeUnits -= *blockSize;
+        physical->requestedUnits += size;
+        physical->allocatedUnits += *blockSize;
+    }
+    physical->allocateNanos += getMonotonicNanoTime() - startTime;
+    return base;
+}
+
+/**
+ * Free a block taken by allocatePhysical
+ * @param physical physical memory
+ * @param base first unit of the block
+ * @param blockSize size of the block, as given by allocatePhysical
+ */
+void releasePhysical(PhysicalMemoryType *physical, int base, int blockSize) {
+    long long startTime = getMonotonicNanoTime();
+    if (physical->allocCode == MEM_ALLOC_BUDDY_CODE) {
+        releaseBuddy(physical, base, floorLog2(blockSize));
+    } else {
+        releaseSegregated(physical, base, blockSize);
+    }
+    physical->freeUnits += blockSize;
+    physical->releaseCount++;
+    physical->releaseNanos += getMonotonicNanoTime() - startTime;
+}
+
+/**
+ * Display the allocator metrics of a run
+ * @param physical physical memory, or NULL
+ */
+void displayPhysicalMemory(PhysicalMemoryType *physical) {
+    char displayString[STD_STR_LEN];
+    if (physical == NULL || physical->requestCount == 0) {
+        return;
+    }
+    configCodeToString(physical->allocCode, displayString);
+    printf("Memory allocator: %s, %lld requests, %lld failed (%.2f%%)\n", displayString, physical->requestCount,
+           physical->failureCount, 100.0 * physical->failureCount / physical->requestCount);
+    printf("Memory fragmentation: internal %.2f%%, external mean %.2f%%\n",
+           physical->allocatedUnits > 0
+               ? 100.0 * (physical->allocatedUnits - physical->requestedUnits) / physical->allocatedUnits : 0.0,
+           100.0 * physical->externalFragmentationSum / physical->requestCount);
+    printf("Memory allocator cost: allocate mean %lld ns, free mean %lld ns\n",
+           physical->allocateNanos / physical->requestCount,
+           physical->releaseCount > 0 ? physical->releaseNanos / physical->releaseCount : 0);
+}
@@ -0,0 +1,52 @@
+#ifndef PHYSICALMEMORY_H
+#define PHYSICALMEMORY_H
+
+#include "datatypes.h"
+#include "configops.h"
+
+// GLOBAL CONSTANTS
+extern const int PHYSICAL_NO_BLOCK;
+
+// one size class per power of two a block length can have
+#define PHYSICAL_CLASS_COUNT 32
+
+/**
+ * Model of a physical allocator for the memAvailable pool, in units of 1 KB.
+ * A buddy allocator keeps one free bitmap per block order.
+ * A segregated free-list allocator keeps a bitmap of used units, with free extents
+ * binned by the power of two below their length and tagged with it at both ends.
+ */
+typedef struct PhysicalMemoryType {
+    int allocCode;
+    int size;
+    int freeUnits;
+    // buddy allocator
+    int maxOrder;
+    unsigned long long *freeBitmaps[PHYSICAL_CLASS_COUNT];
+    int freeCounts[PHYSICAL_CLASS_COUNT];
+    // segregated free-list allocator
+    unsigned long long *usedBitmap;
+    int *extentTags;
+    int *binNext;
+    int *binPrev;
+    int binHeads[PHYSICAL_CLASS_COUNT];
+    unsigned int binMap;
+    // allocator metrics
+    long long requestCount;
+    long long failureCount;
+    long long releaseCount;
+    long long requestedUnits;
+    long long allocatedUnits;
+    double externalFragmentationSum;
+    long long allocateNanos;
+    long long releaseNanos;
+} PhysicalMemoryType;
+
+// function prototypes
+PhysicalMemoryType *createPhysicalMemory(int allocCode, int size);
+PhysicalMemoryType *clearPhysicalMemory(PhysicalMemoryType *physical);
+int allocatePhysical(PhysicalMemoryType *physical, int size, int *blockSize);
+void releasePhysical(PhysicalMemoryType *physical, int base, int blockSize);
+void displayPhysicalMemory(PhysicalMemoryType *physical);
+
+#endif
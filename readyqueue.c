@@ -0,0 +1,282 @@
+#include "readyqueue.h"
+
+const int READY_NOT_QUEUED = -1;
+
+/**
+ * Check if one ready entry has to be dispatched before another one
+ * @param one first entry
+ * @param other second entry
+ * @return True if one comes before other
+ */
+static Boolean readyBefore(ReadyEntryType *one, ReadyEntryType *other) {
+    if (one->key != other->key) {
+        return one->key < other->key;
+    }
+    // equal keys are dispatched in the order they became ready
+    return one->sequence < other->sequence;
+}
+
+/**
+ * Store an entry at a heap index and tell its process where it is
+ * @param queue ready queue
+ * @param index heap index
+ * @param entry entry to store
+ */
+static void placeReady(ReadyQueueType *queue, int index, ReadyEntryType entry) {
+    queue->entries[index] = entry;
+    *entry.position = index;
+}
+
+/**
+ * Move an entry up from a heap index until its parent comes before it
+ * @param queue ready queue
+ * @param index heap index the entry starts at
+ * @param entry entry to place
+ */
+static void siftReadyUp(ReadyQueueType *queue, int index, ReadyEntryType entry) {
+    while (index > 0) {
+        int parent = (index - 1) / 2;
+        if (!readyBefore(&entry, &queue->entries[parent])) {
+            break;
+        }
+        placeReady(queue, index, queue->entries[parent]);
+        index = parent;
+    }
+    placeReady(queue, index, entry);
+}
+
+/**
+ * Move an entry down from a heap index until it comes before both its children
+ * @param queue ready queue
+ * @param index heap index the entry starts at
+ * @param entry entry to place
+ */
+static void siftReadyDown(ReadyQueueType *queue, int index, ReadyEntryType entry) {
+    while (True) {
+        int child = index * 2 + 1;
+        if (child >= queue->count) {
+            break;
+        }
+        if (child + 1 < queue->count && readyBefore(&queue->entries[child + 1], &queue->entries[child])) {
+            child++;
+        }
+        if (!readyBefore(&queue->entries[child], &entry)) {
+            break;
+        }
+        placeReady(queue, index, queue->entries[child]);
+        index = child;
+    }
+    placeReady(queue, index, entry);
+}
+
+/**
+ * Create an empty ready queue
+ * @param capacity initial amount of processes the queue can hold
+ * @return new ready queue
+ */
+ReadyQueueType *createReadyQueue(int capacity) {
+    ReadyQueueType *queue = calloc(1, sizeof(ReadyQueueType));
+    if (capacity < 1) {
+        capacity = 1;
+    }
+    queue->entries = malloc(capacity * sizeof(ReadyEntryType));
+    queue->capacity = capacity;
+    return queue;
+}
+
+/**
+ * Free a ready queue
+ * @param queue ready queue
+ * @return NULL
+ */
+ReadyQueueType *clearReadyQueue(ReadyQueueType *queue) {
+    if (queue != NULL) {
+        free(queue->entries);
+        free(queue);
+    }
+    return NULL;
+}
+
+/**
+ * Add a process to the queue
+ * @param queue ready queue
+ * @param key scheduling key, the lowest key is dispatched first
+ * @param pid process id
+ * @param position where the queue keeps the heap index of the process until it is removed
+ */
+void pushReady(ReadyQueueType *queue, long long key, int pid, int *position) {
+    // grow the heap when it is full
+    if (queue->count == queue->capacity) {
+        queue->capacity *= 2;
+        queue->entries = realloc(queue->entries, queue->capacity * sizeof(ReadyEntryType));
+    }
+
+    ReadyEntryType entry;
+    entry.key = key;
+    entry.sequence = queue->nextSequence++;
+    entry.pid = pid;
+    entry.position = position;
+    siftReadyUp(queue, queue->count++, entry);
+}
+
+/**
+ * Get the process with the lowest key without removing it
+ * @param queue ready queue
+ * @param pid output for the process id
+ * @param key output for its key
+ * @return False if the queue is empty
+ */
+Boolean peekReady(ReadyQueueType *queue, int *pid, long long *key) {
+    if (queue->count == 0) {
+        return False;
+    }
+    *pid = queue->entries[0].pid;
+    *key = queue->entries[0].key;
+    return True;
+}
+
+/**
+ * Get the first process other than a given one without removing it.
+ * Only the root's children can come second, so this is as cheap as peekReady.
+ * @param queue ready queue
+ * @param excludedPid process to pass over, such as the one running
+ * @param pid output for the process id
+ * @param key output for its key
+ * @return False if the queue holds no other process
+ */
+Boolean peekReadyExcept(ReadyQueueType *queue, int excludedPid, int *pid, long long *key) {
+    int index = 0;
+    if (queue->count > 0 && queue->entries[0].pid == excludedPid) {
+        index = 1;
+        if (queue->count > 2 && readyBefore(&queue->entries[2], &queue->entries[1])) {
+            index = 2;
+        }
+    }
+    if (index >= queue->count) {
+        return False;
+    }
+    *pid = queue->entries[index].pid;
+    *key = queue->entries[index].key;
+    return True;
+}
+
+/**
+ * Change the key of a queued process, it keeps its place among processes with the same key
+ * @param queue ready queue
+ * @param position heap index of the process, as given to pushReady
+ * @param key new scheduling key
+ */
+void updateReadyKey(ReadyQueueType *queue, int *position, long long key) {
+    ReadyEntryType entry = queue->entries[*position];
+    Boolean decreased = key < entry.key;
+    entry.key = key;
+    if (decreased == True) {
+        siftReadyUp(queue, *position, entry);
+    } else {
+        siftReadyDown(queue, *position, entry);
+    }
+}
+
+/**
+ * Remove a queued process
+ * @param queue ready queue
+ * @param position heap index of the process, as given to pushReady, set to READY_NOT_QUEUED
+ */
+void removeReady(ReadyQueueType *queue, int *position) {
+    int index = *position;
+    *position = READY_NOT_QUEUED;
+
+    // the last entry fills the hole, from there it can have to move either way
+    ReadyEntryType last = queue->entries[--queue->count];
+    if (index == queue->count) {
+        return;
+    }
+    if (index > 0 && readyBefore(&last, &queue->entries[(index - 1) / 2])) {
+        siftReadyUp(queue, index, last);
+    } else {
+        siftReadyDown(queue, index, last);
+    }
+}
+
+/**
+ * Check if there are no processes waiting
+ * @param queue ready queue
+ * @return True if the queue is empty
+ */
+Boolean isReadyQueueEmpty(ReadyQueueType *queue) {
+    return queue->count == 0;
+}
+
+/**
+ * Create an empty ready ring
+ * @param capacity initial amount of processes the ring can hold
+ * @return new ready ring
+ */
+ReadyRingType *createReadyRing(int capacity) {
+    ReadyRingType *ring = calloc(1, sizeof(ReadyRingType));
+    if (capacity < 1) {
+        capacity = 1;
+    }
+    ring->pids = malloc(capacity * sizeof(int));
+    ring->capacity = capacity;
+    return ring;
+}
+
+/**
+ * Free a ready ring
+ * @param ring ready ring
+ * @return NULL
+ */
+ReadyRingType *clearReadyRing(ReadyRingType *ring) {
+    if (ring != NULL) {
+        free(ring->pids);
+        free(ring);
+    }
+    return NULL;
+}
+
+/**
+ * Add a process at the tail of the ring
+ * @param ring ready ring
+ * @param pid process id
+ */
+void pushReadyRing(ReadyRingType *ring, int pid) {
+    // grow the ring when it is full, unwrapping it into the new space
+    if (ring->count == ring->capacity) {
+        int *pids = malloc(ring->capacity * 2 * sizeof(int));
+        for (int index = 0; index < ring->count; index++) {
+            pids[index] = ring->pids[(ring->head + index) % ring->capacity];
+        }
+        free(ring->pids);
+        ring->pids = pids;
+        ring->head = 0;
+        ring->capacity *= 2;
+    }
+    ring->pids[(ring->head + ring->count) % ring->capacity] = pid;
+    ring->count++;
+}
+
+/**
+ * Remove the process at the head of the ring
+ * @param ring ready ring
+ * @param pid output for the process id
+ * @return False if the ring was empty
+ */
+Boolean popReadyRing(ReadyRingType *ring, int *pid) {
+    if (ring->count == 0) {
+        return False;
+    }
+    *pid = ring->pids[ring->head];
+    ring->head = (ring->head + 1) % ring->capacity;
+    ring->count--;
+    return True;
+}
+
+/**
+ * Check if there are no processes waiting in the ring
+ * @param ring ready ring
+ * @return True if the ring is empty
+ */
+Boolean isReadyRingEmpty(ReadyRingType *ring) {
+    return ring->count == 0;
+}
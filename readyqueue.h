@@ -0,0 +1,55 @@
+#ifndef READYQUEUE_H
+#define READYQUEUE_H
+
+#include "datatypes.h"
+
+// GLOBAL CONSTANTS
+extern const int READY_NOT_QUEUED;
+
+/**
+ * A process waiting for the cpu, ordered by its scheduling key and then by the order it became ready.
+ * position points at the process's own copy of its heap index, so the entry can be found again.
+ */
+typedef struct ReadyEntryType {
+    long long key;
+    long long sequence;
+    int pid;
+    int *position;
+} ReadyEntryType;
+
+/**
+ * Indexed binary min-heap of processes waiting for the cpu
+ */
+typedef struct ReadyQueueType {
+    ReadyEntryType *entries;
+    int count;
+    int capacity;
+    long long nextSequence;
+} ReadyQueueType;
+
+/**
+ * Circular FIFO of processes waiting for the cpu, dispatched in the order they became ready
+ */
+typedef struct ReadyRingType {
+    int *pids;
+    int head;
+    int count;
+    int capacity;
+} ReadyRingType;
+
+// function prototypes
+ReadyQueueType *createReadyQueue(int capacity);
+ReadyQueueType *clearReadyQueue(ReadyQueueType *queue);
+void pushReady(ReadyQueueType *queue, long long key, int pid, int *position);
+Boolean peekReady(ReadyQueueType *queue, int *pid, long long *key);
+Boolean peekReadyExcept(ReadyQueueType *queue, int excludedPid, int *pid, long long *key);
+void updateReadyKey(ReadyQueueType *queue, int *position, long long key);
+void removeReady(ReadyQueueType *queue, int *position);
+Boolean isReadyQueueEmpty(ReadyQueueType *queue);
+ReadyRingType *createReadyRing(int capacity);
+ReadyRingType *clearReadyRing(ReadyRingType *ring);
+void pushReadyRing(ReadyRingType *ring, int pid);
+Boolean popReadyRing(ReadyRingType *ring, int *pid);
+Boolean isReadyRingEmpty(ReadyRingType *ring);
+
+#endif
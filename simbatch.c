@@ -0,0 +1,307 @@
+#include "simbatch.h"
+
+const int MAX_BATCH_THREADS = 256;
+// limits the cartesian product, a batch keeps a config copy per run
+const int MAX_BATCH_RUNS = 65536;
+
+/**
+ * Split a comma separated value list into a sweep of one config item
+ * @param sweep sweep to fill
+ * @param prompt config line prompt of the swept item, eg "Quantum Time (cycles)"
+ * @param valueList values, eg "2,4,8"
+ * @return False if the prompt is unknown, a value is empty or too long, or there are too many values
+ */
+Boolean parseSweep(SweepType *sweep, char *prompt, char *valueList) {
+    int listIndex = 0;
+    int valueLength = 0;
+
+    if (getDataLineCode(prompt) == CFG_CORRUPT_PROMPT_ERR) {
+        return False;
+    }
+    sweep->prompt = prompt;
+    sweep->valueCount = 0;
+    while (True) {
+        char listChar = valueList[listIndex++];
+        if (listChar == COMMA || listChar == NULL_CHAR) {
+            if (valueLength == 0 || sweep->valueCount == MAX_SWEEP_VALUES) {
+                return False;
+            }
+            sweep->values[sweep->valueCount++][valueLength] = NULL_CHAR;
+            valueLength = 0;
+            if (listChar == NULL_CHAR) {
+                return True;
+            }
+        } else {
+            if (valueLength == SWEEP_VALUE_LEN - 1 || sweep->valueCount == MAX_SWEEP_VALUES) {
+                return False;
+            }
+            sweep->values[sweep->valueCount][valueLength++] = listChar;
+        }
+    }
+}
+
+/**
+ * Fill a sweep with every cpu scheduling code, for comparing the schedulers on the same workload
+ * @param sweep sweep to fill
+ */
+void setSchedulerSweep(SweepType *sweep) {
+    parseSweep(sweep, "CPU Scheduling Code", "SJF-N,SRTF-P,FCFS-P,RR-P,FCFS-N");
+}
+
+/**
+ * Give a run its own log file, the config's log name with the run id added before the extension.
+ * Runs share the console, so monitor output goes to the file as well.
+ * @param run batch run
+ * @return False if the new log name does not fit the config data
+ */
+Boolean setRunLogFile(BatchRunType *run) {
+    char *logName = run->config.logToFileName;
+    char runLogName[MAX_STR_LEN];
+    int extensionIndex = getStringLength(logName);
+
+    // find the extension, a dot in a directory name does not count
+    for (int index = extensionIndex - 1; index >= 0 && logName[index] != '/'; index--) {
+        if (logName[index] == PERIOD) {
+            extensionIndex = index;
+            break;
+        }
+    }
+    if (snprintf(runLogName, MAX_STR_LEN, "%.*s_run%d%s", extensionIndex, logName, run->id,
+                 logName + extensionIndex) >= (int) sizeof(run->config.logToFileName)) {
+        return False;
+    }
+    copyString(logName, runLogName);
+    if (run->config.logToCode == LOGTO_MONITOR_CODE || run->config.logToCode == LOGTO_BOTH_CODE) {
+        run->config.logToCode = LOGTO_FILE_CODE;
+    }
+    return True;
+}
+
+/**
+ * Create a batch with one run for every config and every combination of sweep values.
+ * Runs are ordered by config, then by sweep value with the last sweep changing fastest.
+ * @param configs uploaded configs, copied into the runs
+ * @param configFileNames file names of the configs, for display
+ * @param configCount number of configs
+ * @param sweeps swept config items
+ * @param sweepCount number of sweeps
+ * @param endStateMsg error message on failure
+ * @return new batch, NULL if a sweep value is out of range, a log name gets too long or there are too many runs
+ */
+BatchType *createBatch(ConfigDataType **configs, char **configFileNames, int configCount,
+                       SweepType *sweeps, int sweepCount, char *endStateMsg) {
+    long long comboCount = 1;
+    for (int sweepIndex = 0; sweepIndex < sweepCount; sweepIndex++) {
+        comboCount *= sweeps[sweepIndex].valueCount;
+        if (comboCount * configCount > MAX_BATCH_RUNS) {
+            snprintf(endStateMsg, MAX_STR_LEN, "Batch has more than %d runs", MAX_BATCH_RUNS);
+            return NULL;
+        }
+    }
+
+    BatchType *batch = calloc(1, sizeof(BatchType));
+    batch->sweeps = sweeps;
+    batch->sweepCount = sweepCount;
+    batch->runCount = (int) comboCount * configCount;
+    batch->runs = calloc(batch->runCount, sizeof(BatchRunType));
+    for (int runIndex = 0; runIndex < batch->runCount; runIndex++) {
+        BatchRunType *run = &batch->runs[runIndex];
+        int combo = runIndex % (int) comboCount;
+        run->id = runIndex + 1;
+        run->configFileName = configFileNames[runIndex / (int) comboCount];
+        run->config = *configs[runIndex / (int) comboCount];
+
+        // decode the combination, the last sweep changing fastest
+        for (int sweepIndex = sweepCount - 1; sweepIndex >= 0; sweepIndex--) {
+            run->sweepValues[sweepIndex] = combo % sweeps[sweepIndex].valueCount;
+            combo /= sweeps[sweepIndex].valueCount;
+        }
+        for (int sweepIndex = 0; sweepIndex < sweepCount; sweepIndex++) {
+            SweepType *sweep = &sweeps[sweepIndex];
+            if (setConfigValue(&run->config, sweep->prompt, sweep->values[run->sweepValues[sweepIndex]]) == False) {
+                snprintf(endStateMsg, MAX_STR_LEN, "Sweep value %s out of range for %s",
+                         sweep->values[run->sweepValues[sweepIndex]], sweep->prompt);
+                return clearBatch(batch);
+            }
+        }
+        if (setRunLogFile(run) == False) {
+            snprintf(endStateMsg, MAX_STR_LEN, "Log file name of run %d too long", run->id);
+            return clearBatch(batch);
+        }
+    }
+    copyString(endStateMsg, "Batch setup successful.");
+    return batch;
+}
+
+/**
+ * Free a batch and the metadata its runs share, the sweeps belong to the caller
+ * @param batch batch, or NULL
+ * @return NULL
+ */
+BatchType *clearBatch(BatchType *batch) {
+    if (batch != NULL) {
+        for (int index = 0; index < batch->programCount; index++) {
+            clearMetaData(batch->programs[index]);
+        }
+        free(batch->programs);
+        free(batch->runs);
+        free(batch);
+    }
+    return NULL;
+}
+
+/**
+ * Load the metadata of every run, each distinct file only once
+ * @param batch batch
+ * @param forceCompile recompile the metadata caches
+ * @param endStateMsg error message on failure
+ * @return False if a metadata file fails to load
+ */
+Boolean loadBatchMetaData(BatchType *batch, Boolean forceCompile, char *endStateMsg) {
+    // runs that first named each program, for matching the file names of later runs
+    BatchRunType **programRuns = calloc(batch->runCount, sizeof(BatchRunType *));
+    Boolean loaded = True;
+
+    batch->programs = calloc(batch->runCount, sizeof(OpProgramType *));
+    for (int runIndex = 0; runIndex < batch->runCount && loaded == True; runIndex++) {
+        BatchRunType *run = &batch->runs[runIndex];
+        for (int index = 0; index < batch->programCount && run->program == NULL; index++) {
+            if (compareString(programRuns[index]->config.metaDataFileName, run->config.metaDataFileName) == STR_EQ) {
+                run->program = batch->programs[index];
+            }
+        }
+        if (run->program == NULL) {
+            loaded = getCompiledMetaData(run->config.metaDataFileName, &run->program, endStateMsg, forceCompile);
+            if (loaded == True) {
+                programRuns[batch->programCount] = run;
+                batch->programs[batch->programCount++] = run->program;
+            }
+        }
+    }
+    free(programRuns);
+    return loaded;
+}
+
+/**
+ * Main method for a batch worker thread.
+ * Takes the next run nobody has started until every run is taken.
+ */
+void *batchWorkerThread(void *args) {
+    BatchType *batch = (BatchType *) args;
+    int runIndex = __atomic_fetch_add(&batch->nextRun, 1, __ATOMIC_RELAXED);
+    while (runIndex < batch->runCount) {
+        BatchRunType *run = &batch->runs[runIndex];
+        runSimQuiet(&run->config, run->program, &run->result);
+        runIndex = __atomic_fetch_add(&batch->nextRun, 1, __ATOMIC_RELAXED);
+    }
+    return NULL;
+}
+
+/**
+ * Run every simulation of a batch on a fixed pool of threads
+ * @param batch batch with its metadata loaded
+ * @param threadCount number of threads, no more than the number of runs are started
+ */
+void runBatch(BatchType *batch, int threadCount) {
+    if (threadCount > batch->runCount) {
+        threadCount = batch->runCount;
+    }
+    printf("Batch running %d simulations on %d threads\n\n", batch->runCount, threadCount);
+    long long startTime = getMonotonicTime();
+    pthread_t *threads = calloc(threadCount, sizeof(pthread_t));
+    batch->nextRun = 0;
+    for (int index = 0; index < threadCount; index++) {
+        pthread_create(&threads[index], NULL, batchWorkerThread, batch);
+    }
+    for (int index = 0; index < threadCount; index++) {
+        pthread_join(threads[index], NULL);
+    }
+    free(threads);
+    printf("Batch finished in %.3f s\n\n", (getMonotonicTime() - startTime) / 1000000.0);
+}
+
+/**
+ * Write the sweep values of a run as a comma separated list
+ * @param batch batch
+ * @param run batch run
+ * @param lineCode data line code of a sweep to leave out, CFG_CORRUPT_PROMPT_ERR to list every sweep
+ * @param sweepString output string, MAX_STR_LEN long
+ */
+void formatSweepValues(BatchType *batch, BatchRunType *run, int lineCode, char *sweepString) {
+    int sweepLength = 0;
+    sweepString[0] = NULL_CHAR;
+    for (int sweepIndex = 0; sweepIndex < batch->sweepCount && sweepLength < MAX_STR_LEN; sweepIndex++) {
+        SweepType *sweep = &batch->sweeps[sweepIndex];
+        if (getDataLineCode(sweep->prompt) != lineCode) {
+            sweepLength += snprintf(sweepString + sweepLength, MAX_STR_LEN - sweepLength, "%s%s",
+                                    sweepLength > 0 ? "," : "", sweep->values[run->sweepValues[sweepIndex]]);
+        }
+    }
+}
+
+/**
+ * Get the share of the run's core time its cores were busy
+ * @param run batch run that has been run
+ * @return busy percentage
+ */
+double getRunBusyPercent(BatchRunType *run) {
+    long long coreTime = run->result.endTime * run->config.cpuCores;
+    return coreTime > 0 ? 100.0 * run->result.busyTime / coreTime : 0.0;
+}
+
+/**
+ * Display the results of every run in run order, one line per run
+ * @param batch batch that has been run
+ */
+void displayBatchResults(BatchType *batch) {
+    char sweepString[MAX_STR_LEN];
+    char schedString[STD_STR_LEN];
+
+    printf("Batch Results\n-------------\n");
+    for (int sweepIndex = 0; sweepIndex < batch->sweepCount; sweepIndex++) {
+        printf("Sweep %d: %s\n", sweepIndex + 1, batch->sweeps[sweepIndex].prompt);
+    }
+    printf("%5s  %-20s %-7s %-24s %14s %11s %9s %11s %8s  %s\n", "Run", "Config", "Sched", "Sweep values",
+           "End time (s)", "Processes", "Segfaults", "Page faults", "CPU busy", "Log file");
+    for (int runIndex = 0; runIndex < batch->runCount; runIndex++) {
+        BatchRunType *run = &batch->runs[runIndex];
+        SimResultType *result = &run->result;
+
+        formatSweepValues(batch, run, CFG_CORRUPT_PROMPT_ERR, sweepString);
+        configCodeToString(run->config.cpuSchedCode, schedString);
+        printf("%5d  %-20s %-7s %-24s %14.6f %5d/%-5d %9d %11lld %7.2f%%  %s%s\n", run->id, run->configFileName,
+               schedString, sweepString, result->endTime / 1000000.0, result->exitCount, result->processCount,
+               result->segfaultCount, result->pageFaultCount, getRunBusyPercent(run), run->config.logToFileName,
+               result->completed == True ? "" : " (stalled)");
+    }
+    printf("\n");
+}
+
+/**
+ * Display how every cpu scheduling code did on each workload, one line per run.
+ * Times are in milliseconds of simulation time, the scheduler sweep is left out of the sweep values.
+ * @param batch batch that has been run with a scheduler sweep
+ */
+void displaySchedulerComparison(BatchType *batch) {
+    char sweepString[MAX_STR_LEN];
+    char schedString[STD_STR_LEN];
+
+    printf("Scheduler Comparison\n--------------------\n");
+    printf("%5s  %-20s %-24s %-7s %21s %21s %21s\n", "", "", "", "", "Turnaround (ms)", "Waiting (ms)",
+           "Response (ms)");
+    printf("%5s  %-20s %-24s %-7s %10s %10s %10s %10s %10s %10s %8s %9s\n", "Run", "Config", "Sweep values",
+           "Sched", "mean", "p95", "mean", "p95", "mean", "p95", "CPU busy", "Switches");
+    for (int runIndex = 0; runIndex < batch->runCount; runIndex++) {
+        BatchRunType *run = &batch->runs[runIndex];
+        SimResultType *result = &run->result;
+
+        formatSweepValues(batch, run, CFG_CPU_SCHED_CODE, sweepString);
+        configCodeToString(run->config.cpuSchedCode, schedString);
+        printf("%5d  %-20s %-24s %-7s %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f %7.2f%% %9lld%s\n", run->id,
+               run->configFileName, sweepString, schedString, result->turnaround.mean / 1000.0,
+               result->turnaround.p95 / 1000.0, result->waiting.mean / 1000.0, result->waiting.p95 / 1000.0,
+               result->response.mean / 1000.0, result->response.p95 / 1000.0, getRunBusyPercent(run),
+               result->contextSwitchCount, result->completed == True ? "" : " (stalled)");
+    }
+    printf("\n");
+}
@@ -0,0 +1,66 @@
+#ifndef SIMBATCH_H
+#define SIMBATCH_H
+
+#include <pthread.h>
+#include "datatypes.h"
+#include "StringUtils.h"
+#include "metadataops.h"
+#include "metadatacache.h"
+#include "configops.h"
+#include "simulator.h"
+
+// GLOBAL CONSTANTS
+#define MAX_SWEEP_COUNT 8
+#define MAX_SWEEP_VALUES 32
+#define SWEEP_VALUE_LEN 100
+
+extern const int MAX_BATCH_THREADS;
+extern const int MAX_BATCH_RUNS;
+
+/**
+ * One config item swept over a list of values, every run takes one value of every sweep
+ */
+typedef struct SweepType {
+    char *prompt;
+    char values[MAX_SWEEP_VALUES][SWEEP_VALUE_LEN];
+    int valueCount;
+} SweepType;
+
+/**
+ * One simulation of a batch, with its own copy of the config and a program shared with other runs
+ */
+typedef struct BatchRunType {
+    int id;
+    char *configFileName;
+    int sweepValues[MAX_SWEEP_COUNT];
+    ConfigDataType config;
+    OpProgramType *program;
+    SimResultType result;
+} BatchRunType;
+
+/**
+ * Cartesian product of configs and sweeps, run by a fixed pool of threads.
+ * Every distinct metadata file is loaded once, before the threads start, and only read by the runs.
+ */
+typedef struct BatchType {
+    BatchRunType *runs;
+    int runCount;
+    int nextRun;
+    SweepType *sweeps;
+    int sweepCount;
+    OpProgramType **programs;
+    int programCount;
+} BatchType;
+
+// function prototypes
+Boolean parseSweep(SweepType *sweep, char *prompt, char *valueList);
+void setSchedulerSweep(SweepType *sweep);
+BatchType *createBatch(ConfigDataType **configs, char **configFileNames, int configCount,
+                       SweepType *sweeps, int sweepCount, char *endStateMsg);
+BatchType *clearBatch(BatchType *batch);
+Boolean loadBatchMetaData(BatchType *batch, Boolean forceCompile, char *endStateMsg);
+void runBatch(BatchType *batch, int threadCount);
+void displayBatchResults(BatchType *batch);
+void displaySchedulerComparison(BatchType *batch);
+
+#endif
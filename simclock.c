@@ -0,0 +1,158 @@
+#include "simclock.h"
+
+// sleep until this many microseconds before a deadline, then spin for the rest
+const long long TIMER_SPIN_USEC = 500;
+
+/**
+ * Read the monotonic host clock
+ * @return microseconds on the monotonic clock
+ */
+long long getMonotonicTime() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (long long) now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+/**
+ * Read the monotonic host clock at full resolution, for timing short operations
+ * @return nanoseconds on the monotonic clock
+ */
+long long getMonotonicNanoTime() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (long long) now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+/**
+ * Block until the monotonic clock reaches an absolute deadline.
+ * Sleeps for most of the wait and only spins for the last fraction of a millisecond,
+ * so a long wait does not keep a host core busy.
+ * @param deadline absolute monotonic time in microseconds
+ */
+void sleepUntil(long long deadline) {
+    long long sleepDeadline = deadline - TIMER_SPIN_USEC;
+    if (getMonotonicTime() < sleepDeadline) {
+        struct timespec wakeTime;
+        wakeTime.tv_sec = (time_t) (sleepDeadline / 1000000);
+        wakeTime.tv_nsec = (long) (sleepDeadline % 1000000) * 1000;
+        // absolute sleeps restart cleanly when interrupted by a signal, any other error leaves the rest to the spin
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wakeTime, NULL) == EINTR) {
+        }
+    }
+    while (getMonotonicTime() < deadline) {
+    }
+}
+
+/**
+ * Block until the monotonic clock reaches an absolute deadline, timing the sleep
+ * @param deadline absolute monotonic time in microseconds
+ * @param stats timer stats to record how long the sleep asked for and took, NULL to only sleep
+ */
+void recordSleepUntil(long long deadline, TimerStatsType *stats) {
+    if (stats == NULL) {
+        sleepUntil(deadline);
+        return;
+    }
+    long long startTime = getMonotonicNanoTime();
+    sleepUntil(deadline);
+    long long endTime = getMonotonicNanoTime();
+    long long requested = deadline * 1000 - startTime;
+    // a deadline already gone is kept apart, its sleep asks for nothing and lateness is only the wake up cost
+    if (requested < 0) {
+        recordHistogram(&stats->overdue, -requested);
+        requested = 0;
+    }
+    recordHistogram(&stats->requested, requested);
+    recordHistogram(&stats->actual, endTime - startTime);
+    recordHistogram(&stats->late, endTime - startTime - requested);
+}
+
+/**
+ * Start the simulation clock at time zero
+ * @param clock simulation clock
+ * @param mode CLOCK_REAL_CODE to follow the wall clock, CLOCK_VIRTUAL_CODE to jump between events
+ */
+void startSimClock(SimClockType *clock, int mode) {
+    clock->mode = mode;
+    clock->idealTime = 0;
+    clock->waitCount = 0;
+    clock->lastDrift = 0;
+    clock->maxDrift = 0;
+    clock->totalDrift = 0;
+    clock->waitStats = NULL;
+    clock->startTime = getMonotonicTime();
+}
+
+/**
+ * Get the current simulation time
+ * @param clock simulation clock
+ * @return microseconds since the clock was started
+ */
+long long getSimTime(SimClockType *clock) {
+    if (clock->mode == CLOCK_VIRTUAL_CODE) {
+        return clock->idealTime;
+    }
+    return getMonotonicTime() - clock->startTime;
+}
+
+/**
+ * Get the time the simulation would be at if every wait ended exactly on its deadline.
+ * New events are scheduled from here so timer error does not add up across ops.
+ * @param clock simulation clock
+ * @return ideal simulation time in microseconds
+ */
+long long getIdealTime(SimClockType *clock) {
+    return clock->idealTime;
+}
+
+/**
+ * Split a simulation time into seconds and microseconds for display
+ * @param simTime simulation time in microseconds
+ * @return time as a timeval
+ */
+struct timeval simTimeToTimeval(long long simTime) {
+    struct timeval result;
+    result.tv_sec = (long) (simTime / 1000000);
+    result.tv_usec = (long) (simTime % 1000000);
+    return result;
+}
+
+/**
+ * Move the simulation clock forward to the given time.
+ * A virtual clock jumps there immediately, a real clock sleeps until the deadline passes.
+ * @param clock simulation clock
+ * @param targetTime simulation time in microseconds
+ */
+void advanceSimClock(SimClockType *clock, long long targetTime) {
+    // never move the clock backwards
+    if (targetTime <= clock->idealTime) {
+        return;
+    }
+    clock->idealTime = targetTime;
+    if (clock->mode == CLOCK_VIRTUAL_CODE) {
+        return;
+    }
+
+    recordSleepUntil(clock->startTime + targetTime, clock->waitStats);
+
+    // measure how late we woke up compared to the ideal timeline
+    long long drift = getSimTime(clock) - targetTime;
+    clock->waitCount++;
+    clock->lastDrift = drift;
+    clock->totalDrift += drift;
+    if (drift > clock->maxDrift) {
+        clock->maxDrift = drift;
+    }
+}
+
+/**
+ * Display how far the real clock drifted from the ideal timeline
+ * @param clock simulation clock
+ */
+void displayClockDrift(SimClockType *clock) {
+    if (clock->mode == CLOCK_VIRTUAL_CODE || clock->waitCount == 0) {
+        return;
+    }
+    printf("\nTimer drift: final %lld us, max %lld us, mean %lld us over %lld waits\n", clock->lastDrift,
+           clock->maxDrift, clock->totalDrift / clock->waitCount, clock->waitCount);
+}
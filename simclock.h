@@ -0,0 +1,42 @@
+#ifndef SIMCLOCK_H
+#define SIMCLOCK_H
+
+#include <errno.h>
+#include <time.h>
+#include "datatypes.h"
+#include "configops.h"
+#include "simoverhead.h"
+
+// GLOBAL CONSTANTS
+extern const long long TIMER_SPIN_USEC;
+
+/**
+ * Simulation clock, either following the wall clock or jumping between events.
+ * Both modes keep an ideal timeline that every event is scheduled against, a real
+ * clock additionally tracks how far the wall clock drifted from that timeline,
+ * and with waitStats set times every sleep it makes.
+ */
+typedef struct SimClockType {
+    int mode;
+    long long startTime;
+    long long idealTime;
+    long long waitCount;
+    long long lastDrift;
+    long long maxDrift;
+    long long totalDrift;
+    TimerStatsType *waitStats;
+} SimClockType;
+
+// function prototypes
+long long getMonotonicTime();
+long long getMonotonicNanoTime();
+void sleepUntil(long long deadline);
+void recordSleepUntil(long long deadline, TimerStatsType *stats);
+void startSimClock(SimClockType *clock, int mode);
+long long getSimTime(SimClockType *clock);
+long long getIdealTime(SimClockType *clock);
+struct timeval simTimeToTimeval(long long simTime);
+void advanceSimClock(SimClockType *clock, long long targetTime);
+void displayClockDrift(SimClockType *clock);
+
+#endif
@@ -0,0 +1,366 @@
+#include "simlog.h"
+#include "simtrace.h"
+
+const int LOG_RING_CAPACITY = 1 << 14;
+const int LOG_LINE_MAX = 128;
+
+// bytes the writer formats before handing a batch to stdio
+#define LOG_BATCH_SIZE (1 << 16)
+
+// a sleeping writer is only woken for this many records, anything less waits for its poll
+#define LOG_WAKE_RECORDS 1024
+
+// longest a record waits in the ring before the writer polls for it, in microseconds
+#define LOG_POLL_USEC 5000
+
+/**
+ * Format the core a cpu op record ran on, for a multi-core cpu only
+ * @param record cpu op record, holding the core in intArg2 and the core count in intArg3
+ * @param coreString output buffer of at least 24 chars
+ * @return core text to append to the line, empty on a single core
+ */
+static char *formatCore(LogRecordType *record, char *coreString) {
+    coreString[0] = NULL_CHAR;
+    if (record->intArg3 > 1) {
+        snprintf(coreString, 24, ", core %d", record->intArg2);
+    }
+    return coreString;
+}
+
+/**
+ * Format a log record as the text line the simulator logs for it
+ * @param record log record
+ * @param buffer output buffer
+ * @param bufferSize size of the output buffer, LOG_LINE_MAX always fits a line
+ * @return length of the line
+ */
+int formatLogRecord(LogRecordType *record, char *buffer, int bufferSize) {
+    struct timeval elapsedTime = simTimeToTimeval(record->time);
+    long seconds = (long) elapsedTime.tv_sec;
+    long microseconds = (long) elapsedTime.tv_usec;
+    int length = 0;
+    char coreString[24];
+
+    switch (record->code) {
+        case LOG_SIM_START:
+            length = snprintf(buffer, bufferSize, "  %ld.%06ld, OS: Simulator start\n", seconds, microseconds);
+            break;
+        case LOG_SIM_END:
+            length = snprintf(buffer, bufferSize, "  %ld.%06ld, OS: Simulator end\n", seconds, microseconds);
+            break;
+        case LOG_PROCESS_READY:
+            length = snprintf(buffer, bufferSize, "  %ld.%06ld, OS: Process %d set to READY state from NEW state\n",
+                              seconds, microseconds, record->pid);
+            break;
+        case LOG_PROCESS_RUNNING:
+            length = snprintf(buffer, bufferSize, "  %ld.%06ld, OS: Process %d set from READY to RUNNING\n\n",
+                              seconds, microseconds, record->pid);
+            break;
+        case LOG_PROCESS_BLOCKED:
+            length = snprintf(buffer, bufferSize, "  %ld.%06ld, OS: Process %d set from RUNNING to BLOCKED\n",
+                              seconds, microseconds, record->pid);
+            break;
+        case LOG_PROCESS_UNBLOCKED:
+            length = snprintf(buffer, bufferSize, "  %ld.%06ld, OS: Process %d set from BLOCKED to READY\n",
+                              seconds, microseconds, record->pid);
+            break;
+        case LOG_PROCESS_ENDED:
+            length = snprintf(buffer, bufferSize, "\n  %ld.%06ld, OS: Process %d ended\n",
+                              seconds, microseconds, record->pid);
+            break;
+        case LOG_PROCESS_EXIT:
+            length = snprintf(buffer, bufferSize, "  %ld.%06ld, OS: Process %d set to EXIT\n",
+                              seconds, microseconds, record->pid);
+            break;
+        case LOG_CPU_START:
+            length = snprintf(buffer, bufferSize, "  %ld.%06ld, Process: %d, cpu process operation start%s\n",
+                              seconds, microseconds, record->pid, formatCore(record, coreString));
+            break;
+        case LOG_CPU_END:
+            length = snprintf(buffer, bufferSize, "  %ld.%06ld, Process: %d, cpu process operation end%s\n",
+                              seconds, microseconds, record->pid, formatCore(record, coreString));
+            break;
+        case LOG_IO_START:
+            length = snprintf(buffer, bufferSize, "  %ld.%06ld, Process: %d, %s %sput operation start\n",
+                              seconds, microseconds, record->pid, getArgName(record->argCode),
+                              getInOutName(record->inOutCode));
+            break;
+        case LOG_IO_END:
+            length = snprintf(buffer, bufferSize, "  %ld.%06ld, OS: Interrupt, Process %d, %s %sput operation end\n",
+                              seconds, microseconds, record->pid, getArgName(record->argCode),
+                              getInOutName(record->inOutCode));
+            break;
+        case LOG_CPU_IDLE:
+            length = snprintf(buffer, bufferSize, "  %ld.%06ld, OS: CPU idle, all active processes blocked\n",
+                              seconds, microseconds);
+            break;
+        case LOG_QUANTUM_TIMEOUT:
+            length = snprintf(buffer, bufferSize, "  %ld.%06ld, OS: Process %d quantum time out, cpu process operation end\n",
+                              seconds, microseconds, record->pid);
+            break;
+        case LOG_CPU_INTERRUPTED:
+            length = snprintf(buffer, bufferSize, "  %ld.%06ld, OS: Process %d interrupted, cpu process operation end\n",
+                              seconds, microseconds, record->pid);
+            break;
+        case LOG_PROCESS_PREEMPTED:
+            length = snprintf(buffer, bufferSize, "  %ld.%06ld, OS: Process %d set from RUNNING to READY\n",
+                              seconds, microseconds, record->pid);
+            break;
+        case LOG_CPU_RESUME:
+            length = snprintf(buffer, bufferSize, "  %ld.%06ld, Process: %d, cpu process operation resume%s\n",
+                              seconds, microseconds, record->pid, formatCore(record, coreString));
+            break;
+        case LOG_MEM_ALLOCATE_REQUEST:
+            length = snprintf(buffer, bufferSize, "  %ld.%06ld, Process: %d, mem allocate request (%d, %d)\n",
+                              seconds, microseconds, record->pid, record->intArg2, record->intArg3);
+            break;
+        case LOG_MEM_ALLOCATE_SUCCESS:
+            length = snprintf(buffer, bufferSize, "  %ld.%06ld, Process: %d, successful mem allocate request\n",
+                              seconds, microseconds, record->pid);
+            break;
+        case LOG_MEM_ALLOCATE_FAILURE:
+            length = snprintf(buffer, bufferSize, "  %ld.%06ld, Process: %d, failed mem allocate request\n",
+                              seconds, microseconds, record->pid);
+            break;
+        case LOG_MEM_ACCESS_REQUEST:
+            length = snprintf(buffer, bufferSize, "  %ld.%06ld, Process: %d, mem access request (%d, %d)\n",
+                              seconds, microseconds, record->pid, record->intArg2, record->intArg3);
+            break;
+        case LOG_MEM_ACCESS_SUCCESS:
+            length = snprintf(buffer, bufferSize, "  %ld.%06ld, Process: %d, successful mem access request\n",
+                              seconds, microseconds, record->pid);
+            break;
+        case LOG_MEM_ACCESS_FAILURE:
+            length = snprintf(buffer, bufferSize, "  %ld.%06ld, Process: %d, failed mem access request\n",
+                              seconds, microseconds, record->pid);
+            break;
+        case LOG_SEGFAULT:
+            length = snprintf(buffer, bufferSize, "\n  %ld.%06ld, OS: Segmentation fault, Process %d ended\n",
+                              seconds, microseconds, record->pid);
+            break;
+        case LOG_PAGE_FAULT:
+            length = snprintf(buffer, bufferSize, "  %ld.%06ld, OS: Page fault, Process %d, %d pages to load\n",
+                              seconds, microseconds, record->pid, record->intArg2);
+            break;
+        default:
+            buffer[0] = NULL_CHAR;
+            break;
+    }
+    // a cut off line still only takes up the buffer
+    return length < bufferSize ? length : bufferSize - 1;
+}
+
+/**
+ * Write a formatted batch of log lines to every log target
+ * @param logger logger
+ * @param buffer formatted lines
+ * @param length length of the lines
+ */
+static void writeLogBatch(SimLoggerType *logger, char *buffer, int length) {
+    if (logger->toMonitor == True) {
+        fwrite(buffer, 1, length, stdout);
+    }
+    if (logger->logFile != NULL) {
+        fwrite(buffer, 1, length, logger->logFile);
+    }
+}
+
+/**
+ * Main method for the log writer thread.
+ * Formats whatever the simulator has pushed in batches, sleeps when the ring is empty
+ * and exits once the logger is shut down and the ring is drained.
+ */
+static void *simLoggerThread(void *args) {
+    SimLoggerType *logger = (SimLoggerType *) args;
+    char *buffer = malloc(LOG_BATCH_SIZE);
+    long long mask = logger->capacity - 1;
+    long long head = logger->head;
+    if (logger->overhead != NULL) {
+        logger->startLatency = getMonotonicNanoTime() - logger->createTime;
+    }
+
+    while (True) {
+        long long tail = __atomic_load_n(&logger->tail, __ATOMIC_ACQUIRE);
+        if (head == tail) {
+            // the simulator pushes its last record before it sets shutdown
+            if (__atomic_load_n(&logger->shutdown, __ATOMIC_ACQUIRE) != 0
+                && __atomic_load_n(&logger->tail, __ATOMIC_ACQUIRE) == head) {
+                break;
+            }
+            pthread_mutex_lock(&logger->lock);
+            __atomic_store_n(&logger->writerSleeping, 1, __ATOMIC_SEQ_CST);
+            if (__atomic_load_n(&logger->tail, __ATOMIC_SEQ_CST) == head
+                && __atomic_load_n(&logger->shutdown, __ATOMIC_SEQ_CST) == 0) {
+                struct timespec wakeTime;
+                long long pollTime = getMonotonicTime() + LOG_POLL_USEC;
+                wakeTime.tv_sec = (time_t) (pollTime / 1000000);
+                wakeTime.tv_nsec = (long) (pollTime % 1000000) * 1000;
+                pthread_cond_timedwait(&logger->wake, &logger->lock, &wakeTime);
+            }
+            __atomic_store_n(&logger->writerSleeping, 0, __ATOMIC_SEQ_CST);
+            pthread_mutex_unlock(&logger->lock);
+            continue;
+        }
+
+        long long writeStart = logger->overhead != NULL ? getMonotonicNanoTime() : 0;
+        // a binary trace takes the records as they are
+        if (logger->trace != NULL) {
+            while (head != tail) {
+                writeTraceRecord(logger->trace, &logger->ring[head & mask]);
+                head++;
+            }
+        }
+        int length = 0;
+        while (head != tail && length <= LOG_BATCH_SIZE - LOG_LINE_MAX) {
+            length += formatLogRecord(&logger->ring[head & mask], buffer + length, LOG_LINE_MAX);
+            head++;
+        }
+        // free the slots before writing, so a blocked simulator can go on
+        __atomic_store_n(&logger->head, head, __ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&logger->producerWaiting, __ATOMIC_SEQ_CST) != 0) {
+            pthread_mutex_lock(&logger->lock);
+            pthread_cond_signal(&logger->spaceReady);
+            pthread_mutex_unlock(&logger->lock);
+        }
+        writeLogBatch(logger, buffer, length);
+        if (logger->overhead != NULL) {
+            recordHistogram(&logger->overhead->logWrite, getMonotonicNanoTime() - writeStart);
+        }
+    }
+
+    fflush(stdout);
+    free(buffer);
+    return NULL;
+}
+
+/**
+ * Wake the writer thread if it is waiting and enough records have piled up
+ * @param logger logger
+ * @param pending records in the ring
+ */
+static void wakeLogWriter(SimLoggerType *logger, long long pending) {
+    if (pending >= LOG_WAKE_RECORDS && __atomic_load_n(&logger->writerSleeping, __ATOMIC_SEQ_CST) != 0) {
+        pthread_mutex_lock(&logger->lock);
+        pthread_cond_signal(&logger->wake);
+        pthread_mutex_unlock(&logger->lock);
+    }
+}
+
+/**
+ * Create a logger and start its writer thread
+ * @param logToCode LOGTO_MONITOR_CODE, LOGTO_FILE_CODE, LOGTO_BOTH_CODE or LOGTO_TRACE_CODE
+ * @param logFileName file to log to, opened for writing when logging to a file or a trace
+ * @param fullCode LOG_FULL_BLOCK_CODE to wait for the writer when the ring is full, LOG_FULL_DROP_CODE to drop the record
+ * @param overhead overhead histograms the writer's start, batches and join go to, NULL to not record them
+ * @return new logger
+ */
+SimLoggerType *createSimLogger(int logToCode, char *logFileName, int fullCode, SimOverheadType *overhead) {
+    SimLoggerType *logger = calloc(1, sizeof(SimLoggerType));
+    logger->capacity = LOG_RING_CAPACITY;
+    logger->ring = malloc(logger->capacity * sizeof(LogRecordType));
+    logger->fullCode = fullCode;
+    logger->toMonitor = logToCode == LOGTO_BOTH_CODE || logToCode == LOGTO_MONITOR_CODE;
+    if (logToCode == LOGTO_BOTH_CODE || logToCode == LOGTO_FILE_CODE) {
+        logger->logFile = fopen(logFileName, "w");
+    }
+    if (logToCode == LOGTO_TRACE_CODE) {
+        logger->trace = createTraceWriter(logFileName);
+        if (logger->trace == NULL) {
+            printf("Trace file %s could not be created, nothing will be logged\n", logFileName);
+        }
+    }
+    pthread_mutex_init(&logger->lock, NULL);
+    // the writer polls on the same monotonic clock as the simulation clock
+    pthread_condattr_t conditionAttributes;
+    pthread_condattr_init(&conditionAttributes);
+    pthread_condattr_setclock(&conditionAttributes, CLOCK_MONOTONIC);
+    pthread_cond_init(&logger->wake, &conditionAttributes);
+    pthread_condattr_destroy(&conditionAttributes);
+    pthread_cond_init(&logger->spaceReady, NULL);
+    logger->overhead = overhead;
+    logger->createTime = getMonotonicNanoTime();
+    pthread_create(&logger->thread, NULL, simLoggerThread, logger);
+    return logger;
+}
+
+/**
+ * Flush every pushed record, stop the writer thread and close the log file
+ * @param logger logger, or NULL
+ * @return NULL
+ */
+SimLoggerType *closeSimLogger(SimLoggerType *logger) {
+    if (logger == NULL) {
+        return NULL;
+    }
+    long long joinStart = getMonotonicNanoTime();
+    __atomic_store_n(&logger->shutdown, 1, __ATOMIC_SEQ_CST);
+    pthread_mutex_lock(&logger->lock);
+    pthread_cond_signal(&logger->wake);
+    pthread_mutex_unlock(&logger->lock);
+    pthread_join(logger->thread, NULL);
+    if (logger->overhead != NULL) {
+        recordHistogram(&logger->overhead->threadJoin, getMonotonicNanoTime() - joinStart);
+        recordHistogram(&logger->overhead->threadStart, logger->startLatency);
+    }
+
+    if (logger->dropCount > 0) {
+        printf("Log dropped %lld records, the log writer fell behind\n", logger->dropCount);
+    }
+    if (logger->logFile != NULL) {
+        fclose(logger->logFile);
+    }
+    logger->trace = closeTraceWriter(logger->trace);
+    pthread_mutex_destroy(&logger->lock);
+    pthread_cond_destroy(&logger->wake);
+    pthread_cond_destroy(&logger->spaceReady);
+    free(logger->ring);
+    free(logger);
+    return NULL;
+}
+
+/**
+ * Push a log record from the simulator thread, nothing is formatted or written here
+ * @param logger logger
+ * @param time simulation time of the event
+ * @param code LogEventCode of the event
+ * @param pid process the event belongs to
+ * @param op op code of a device or memory event, NULL for others
+ */
+void logSimEvent(SimLoggerType *logger, long long time, int code, int pid, OpCodeType *op) {
+    long long tail = logger->tail;
+
+    if (tail - __atomic_load_n(&logger->head, __ATOMIC_ACQUIRE) == logger->capacity) {
+        if (logger->fullCode == LOG_FULL_DROP_CODE) {
+            logger->dropCount++;
+            return;
+        }
+        // block until the writer frees a slot
+        wakeLogWriter(logger, logger->capacity);
+        pthread_mutex_lock(&logger->lock);
+        __atomic_store_n(&logger->producerWaiting, 1, __ATOMIC_SEQ_CST);
+        while (tail - __atomic_load_n(&logger->head, __ATOMIC_SEQ_CST) == logger->capacity) {
+            pthread_cond_wait(&logger->spaceReady, &logger->lock);
+        }
+        __atomic_store_n(&logger->producerWaiting, 0, __ATOMIC_SEQ_CST);
+        pthread_mutex_unlock(&logger->lock);
+    }
+
+    LogRecordType *record = &logger->ring[tail & (logger->capacity - 1)];
+    record->time = time;
+    record->code = code;
+    record->pid = pid;
+    record->argCode = op != NULL ? op->argCode : 0;
+    record->inOutCode = op != NULL ? op->inOutCode : IO_NONE;
+    // only memory requests, page faults and cpu ops on a multi-core cpu print the numbers of their op,
+    // leaving them out everywhere else keeps traces small
+    if (op != NULL && (code == LOG_MEM_ALLOCATE_REQUEST || code == LOG_MEM_ACCESS_REQUEST || code == LOG_PAGE_FAULT
+                       || code == LOG_CPU_START || code == LOG_CPU_END || code == LOG_CPU_RESUME)) {
+        record->intArg2 = op->intArg2;
+        record->intArg3 = op->intArg3;
+    } else {
+        record->intArg2 = 0;
+        record->intArg3 = 0;
+    }
+    __atomic_store_n(&logger->tail, tail + 1, __ATOMIC_SEQ_CST);
+    wakeLogWriter(logger, tail + 1 - __atomic_load_n(&logger->head, __ATOMIC_RELAXED));
+}
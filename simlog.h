@@ -0,0 +1,92 @@
+#ifndef SIMLOG_H
+#define SIMLOG_H
+
+#include <pthread.h>
+#include "datatypes.h"
+#include "StringUtils.h"
+#include "metadataops.h"
+#include "configops.h"
+#include "simclock.h"
+
+// GLOBAL CONSTANTS
+extern const int LOG_RING_CAPACITY;
+extern const int LOG_LINE_MAX;
+
+typedef enum {
+    LOG_SIM_START,
+    LOG_SIM_END,
+    LOG_PROCESS_READY,
+    LOG_PROCESS_RUNNING,
+    LOG_PROCESS_BLOCKED,
+    LOG_PROCESS_UNBLOCKED,
+    LOG_PROCESS_ENDED,
+    LOG_PROCESS_EXIT,
+    LOG_CPU_START,
+    LOG_CPU_END,
+    LOG_IO_START,
+    LOG_IO_END,
+    LOG_CPU_IDLE,
+    LOG_QUANTUM_TIMEOUT,
+    LOG_CPU_INTERRUPTED,
+    LOG_PROCESS_PREEMPTED,
+    LOG_CPU_RESUME,
+    LOG_MEM_ALLOCATE_REQUEST,
+    LOG_MEM_ALLOCATE_SUCCESS,
+    LOG_MEM_ALLOCATE_FAILURE,
+    LOG_MEM_ACCESS_REQUEST,
+    LOG_MEM_ACCESS_SUCCESS,
+    LOG_MEM_ACCESS_FAILURE,
+    LOG_SEGFAULT,
+    LOG_PAGE_FAULT
+} LogEventCode;
+
+/**
+ * One log line, kept as the event that caused it until the writer formats it
+ */
+typedef struct LogRecordType {
+    long long time;
+    int code;
+    int pid;
+    int argCode;
+    int inOutCode;
+    int intArg2;
+    int intArg3;
+} LogRecordType;
+
+/**
+ * Single producer ring of log records, drained by a writer thread.
+ * The simulator thread only writes tail and the writer thread only writes head,
+ * they sit on separate cache lines so the two threads do not fight over them.
+ * With overhead recording on the writer times how long it took to start and every batch it writes.
+ */
+typedef struct SimLoggerType {
+    LogRecordType *ring;
+    long long capacity;
+    int fullCode;
+    Boolean toMonitor;
+    FILE *logFile;
+    struct TraceWriterType *trace;
+    long long dropCount;
+    char tailPadding[64];
+    long long tail;
+    char headPadding[64];
+    long long head;
+    int writerSleeping;
+    int producerWaiting;
+    int shutdown;
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    pthread_cond_t spaceReady;
+    SimOverheadType *overhead;
+    long long createTime;
+    long long startLatency;
+} SimLoggerType;
+
+// function prototypes
+int formatLogRecord(LogRecordType *record, char *buffer, int bufferSize);
+SimLoggerType *createSimLogger(int logToCode, char *logFileName, int fullCode, SimOverheadType *overhead);
+SimLoggerType *closeSimLogger(SimLoggerType *logger);
+void logSimEvent(SimLoggerType *logger, long long time, int code, int pid, OpCodeType *op);
+
+#endif
@@ -0,0 +1,305 @@
+#include "simmetrics.h"
+
+/**
+ * Order two times for qsort
+ * @param one first time
+ * @param other second time
+ * @return negative, zero or positive as one is below, equal to or above other
+ */
+static int compareTimes(const void *one, const void *other) {
+    long long oneTime = *(const long long *) one;
+    long long otherTime = *(const long long *) other;
+    return (oneTime > otherTime) - (oneTime < otherTime);
+}
+
+/**
+ * Summarize a list of times, sorting it
+ * @param times times, one per process
+ * @param count number of times
+ * @return unrounded mean and nearest rank 95th percentile, zero for an empty list
+ */
+static MetricSummaryType summarizeTimes(long long *times, int count) {
+    MetricSummaryType summary = {0, 0};
+    long long total = 0;
+    if (count == 0) {
+        return summary;
+    }
+    qsort(times, count, sizeof(long long), compareTimes);
+    for (int index = 0; index < count; index++) {
+        total += times[index];
+    }
+    summary.mean = (double) total / count;
+    summary.p95 = times[(count * 95 + 99) / 100 - 1];
+    return summary;
+}
+
+/**
+ * Create an empty process accounting list
+ * @return new metrics
+ */
+SimMetricsType *createSimMetrics() {
+    SimMetricsType *metrics = calloc(1, sizeof(SimMetricsType));
+    metrics->capacity = 16;
+    metrics->processes = malloc(metrics->capacity * sizeof(ProcessMetricsType));
+    return metrics;
+}
+
+/**
+ * Free a process accounting list
+ * @param metrics metrics, or NULL
+ * @return NULL
+ */
+SimMetricsType *clearSimMetrics(SimMetricsType *metrics) {
+    if (metrics != NULL) {
+        free(metrics->processes);
+        free(metrics);
+    }
+    return NULL;
+}
+
+/**
+ * Add the accounting of an exited process
+ * @param metrics metrics
+ * @param process accounting of the process, copied
+ */
+void addProcessMetrics(SimMetricsType *metrics, ProcessMetricsType *process) {
+    if (metrics->count == metrics->capacity) {
+        metrics->capacity *= 2;
+        metrics->processes = realloc(metrics->processes, metrics->capacity * sizeof(ProcessMetricsType));
+    }
+    metrics->processes[metrics->count++] = *process;
+}
+
+/**
+ * Summarize the turnaround, waiting and response times of the exited processes.
+ * Turnaround runs from arrival to exit, waiting is the time spent READY and response runs from arrival
+ * to the first dispatch.
+ * @param metrics metrics
+ * @param turnaround turnaround summary
+ * @param waiting waiting summary
+ * @param response response summary
+ */
+void summarizeProcessMetrics(SimMetricsType *metrics, MetricSummaryType *turnaround, MetricSummaryType *waiting,
+                             MetricSummaryType *response) {
+    *turnaround = summarizeMetric(metrics, METRIC_TURNAROUND);
+    *waiting = summarizeMetric(metrics, METRIC_READY);
+    *response = summarizeMetric(metrics, METRIC_RESPONSE);
+}
+
+/**
+ * Get one summarized value of a process
+ * @param process accounting of the process
+ * @param metricCode ProcessMetricCode of the value
+ * @return value, a time in microseconds or a count
+ */
+long long getProcessMetric(ProcessMetricsType *process, int metricCode) {
+    switch (metricCode) {
+        case METRIC_TURNAROUND:
+            return process->endTime - process->arrivalTime;
+        case METRIC_RESPONSE:
+            return process->firstRunTime - process->arrivalTime;
+        case METRIC_READY:
+            return process->readyTime;
+        case METRIC_CPU:
+            return process->cpuTime;
+        case METRIC_IO:
+            return process->ioTime;
+        case METRIC_PREEMPTIONS:
+            return process->preemptCount;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * Get the export name of a summarized value
+ * @param metricCode ProcessMetricCode of the value
+ * @return column name, with its unit
+ */
+static char *getMetricName(int metricCode) {
+    static char *metricNames[METRIC_COUNT] = {
+            "turnaround_us", "response_us", "ready_us", "cpu_us", "io_us", "preemptions"
+    };
+    return metricNames[metricCode];
+}
+
+/**
+ * Summarize one value over the exited processes
+ * @param metrics metrics
+ * @param metricCode ProcessMetricCode of the value
+ * @return mean and 95th percentile
+ */
+MetricSummaryType summarizeMetric(SimMetricsType *metrics, int metricCode) {
+    long long *values = malloc((metrics->count > 0 ? metrics->count : 1) * sizeof(long long));
+    for (int index = 0; index < metrics->count; index++) {
+        values[index] = getProcessMetric(&metrics->processes[index], metricCode);
+    }
+    MetricSummaryType summary = summarizeTimes(values, metrics->count);
+    free(values);
+    return summary;
+}
+
+/**
+ * Order the accounting of two processes by pid for qsort
+ * @param one first process
+ * @param other second process
+ * @return negative, zero or positive as one has a lower, equal or higher pid than other
+ */
+static int compareProcessIds(const void *one, const void *other) {
+    int onePid = ((const ProcessMetricsType *) one)->pid;
+    int otherPid = ((const ProcessMetricsType *) other)->pid;
+    return (onePid > otherPid) - (onePid < otherPid);
+}
+
+/**
+ * Copy the accounting of the exited processes in pid order
+ * @param metrics metrics
+ * @return sorted copy, freed by the caller
+ */
+static ProcessMetricsType *sortProcessMetrics(SimMetricsType *metrics) {
+    ProcessMetricsType *processes = malloc((metrics->count > 0 ? metrics->count : 1) * sizeof(ProcessMetricsType));
+    for (int index = 0; index < metrics->count; index++) {
+        processes[index] = metrics->processes[index];
+    }
+    qsort(processes, metrics->count, sizeof(ProcessMetricsType), compareProcessIds);
+    return processes;
+}
+
+/**
+ * Get the total of one value over the exited processes
+ * @param metrics metrics
+ * @param metricCode ProcessMetricCode of the value
+ * @return total
+ */
+static long long getMetricTotal(SimMetricsType *metrics, int metricCode) {
+    long long total = 0;
+    for (int index = 0; index < metrics->count; index++) {
+        total += getProcessMetric(&metrics->processes[index], metricCode);
+    }
+    return total;
+}
+
+/**
+ * Display the accounting of every exited process in pid order, then its mean and 95th percentile over the run
+ * @param metrics metrics
+ */
+void displayProcessMetrics(SimMetricsType *metrics) {
+    ProcessMetricsType *processes = sortProcessMetrics(metrics);
+    MetricSummaryType summary;
+
+    printf("\nProcess Metrics (us)\n--------------------\n");
+    printf("%6s %12s %12s %12s %12s %12s %12s %12s %12s %8s\n", "pid", "arrival", "first run", "completion",
+           "turnaround", "response", "ready", "cpu", "io", "preempts");
+    for (int index = 0; index < metrics->count; index++) {
+        ProcessMetricsType *process = &processes[index];
+        printf("%6d %12lld %12lld %12lld %12lld %12lld %12lld %12lld %12lld %8d\n", process->pid,
+               process->arrivalTime, process->firstRunTime, process->endTime,
+               getProcessMetric(process, METRIC_TURNAROUND), getProcessMetric(process, METRIC_RESPONSE),
+               process->readyTime, process->cpuTime, process->ioTime, process->preemptCount);
+    }
+    for (int row = 0; row < 2; row++) {
+        printf("%6s %12s %12s %12s", row == 0 ? "mean" : "p95", "", "", "");
+        for (int metricCode = 0; metricCode < METRIC_COUNT; metricCode++) {
+            summary = summarizeMetric(metrics, metricCode);
+            if (row == 0) {
+                printf(metricCode == METRIC_PREEMPTIONS ? " %8.2f" : " %12.1f", summary.mean);
+            } else {
+                printf(metricCode == METRIC_PREEMPTIONS ? " %8lld" : " %12lld", summary.p95);
+            }
+        }
+        printf("\n");
+    }
+    printf("%d processes, %lld us cpu, %lld us io, %lld preemptions, %lld context switches\n", metrics->count,
+           getMetricTotal(metrics, METRIC_CPU), getMetricTotal(metrics, METRIC_IO),
+           getMetricTotal(metrics, METRIC_PREEMPTIONS), metrics->contextSwitchCount);
+    free(processes);
+}
+
+/**
+ * Get the name of the metrics file of a run, the log file name with its extension swapped for the format's
+ * @param logFileName log file name of the run
+ * @param metricsCode METRICS_CSV_CODE or METRICS_JSON_CODE
+ * @param fileName metrics file name, MAX_STR_LEN long
+ */
+void getMetricsFileName(char *logFileName, int metricsCode, char *fileName) {
+    int extensionIndex = getStringLength(logFileName);
+
+    // find the extension, a dot in a directory name does not count
+    for (int index = extensionIndex - 1; index >= 0 && logFileName[index] != '/'; index--) {
+        if (logFileName[index] == PERIOD) {
+            extensionIndex = index;
+            break;
+        }
+    }
+    snprintf(fileName, MAX_STR_LEN, "%.*s_metrics%s", extensionIndex, logFileName,
+             metricsCode == METRICS_JSON_CODE ? ".json" : ".csv");
+}
+
+/**
+ * Write the accounting of every exited process in pid order, with the mean and 95th percentile over the run.
+ * CSV has a row per process followed by a mean and a p95 row, JSON has a list of processes and a summary.
+ * @param metrics metrics
+ * @param metricsCode METRICS_CSV_CODE or METRICS_JSON_CODE
+ * @param fileName metrics file name
+ * @return False if the file can not be written
+ */
+Boolean writeProcessMetrics(SimMetricsType *metrics, int metricsCode, char *fileName) {
+    FILE *metricsFile = fopen(fileName, "w");
+    if (metricsFile == NULL) {
+        return False;
+    }
+    ProcessMetricsType *processes = sortProcessMetrics(metrics);
+    MetricSummaryType summary;
+
+    if (metricsCode == METRICS_CSV_CODE) {
+        fprintf(metricsFile, "pid,arrival_us,first_run_us,completion_us");
+        for (int metricCode = 0; metricCode < METRIC_COUNT; metricCode++) {
+            fprintf(metricsFile, ",%s", getMetricName(metricCode));
+        }
+        fprintf(metricsFile, "\n");
+        for (int index = 0; index < metrics->count; index++) {
+            ProcessMetricsType *process = &processes[index];
+            fprintf(metricsFile, "%d,%lld,%lld,%lld", process->pid, process->arrivalTime, process->firstRunTime,
+                    process->endTime);
+            for (int metricCode = 0; metricCode < METRIC_COUNT; metricCode++) {
+                fprintf(metricsFile, ",%lld", getProcessMetric(process, metricCode));
+            }
+            fprintf(metricsFile, "\n");
+        }
+        for (int row = 0; row < 2; row++) {
+            fprintf(metricsFile, "%s,,,", row == 0 ? "mean" : "p95");
+            for (int metricCode = 0; metricCode < METRIC_COUNT; metricCode++) {
+                summary = summarizeMetric(metrics, metricCode);
+                if (row == 0) {
+                    fprintf(metricsFile, ",%.2f", summary.mean);
+                } else {
+                    fprintf(metricsFile, ",%lld", summary.p95);
+                }
+            }
+            fprintf(metricsFile, "\n");
+        }
+    } else {
+        fprintf(metricsFile, "{\n  \"processes\": [");
+        for (int index = 0; index < metrics->count; index++) {
+            ProcessMetricsType *process = &processes[index];
+            fprintf(metricsFile, "%s\n    {\"pid\": %d, \"arrival_us\": %lld, \"first_run_us\": %lld, "
+                                 "\"completion_us\": %lld", index > 0 ? "," : "", process->pid,
+                    process->arrivalTime, process->firstRunTime, process->endTime);
+            for (int metricCode = 0; metricCode < METRIC_COUNT; metricCode++) {
+                fprintf(metricsFile, ", \"%s\": %lld", getMetricName(metricCode),
+                        getProcessMetric(process, metricCode));
+            }
+            fprintf(metricsFile, "}");
+        }
+        fprintf(metricsFile, "\n  ],\n  \"summary\": {\n    \"processes\": %d,\n    \"context_switches\": %lld",
+                metrics->count, metrics->contextSwitchCount);
+        for (int metricCode = 0; metricCode < METRIC_COUNT; metricCode++) {
+            summary = summarizeMetric(metrics, metricCode);
+            fprintf(metricsFile, ",\n    \"%s\": {\"total\": %lld, \"mean\": %.2f, \"p95\": %lld}",
+                    getMetricName(metricCode), getMetricTotal(metrics, metricCode), summary.mean, summary.p95);
+        }
+        fprintf(metricsFile, "\n  }\n}\n");
+    }
+    free(processes);
+    return fclose(metricsFile) == 0;
+}
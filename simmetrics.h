@@ -0,0 +1,64 @@
+#ifndef SIMMETRICS_H
+#define SIMMETRICS_H
+
+#include "datatypes.h"
+#include "StringUtils.h"
+#include "configops.h"
+
+/**
+ * Scheduling accounting of one process, times in microseconds of simulation time.
+ * cpuTime counts the cpu op time the process ran, ioTime the time it spent BLOCKED on devices and page faults.
+ */
+typedef struct ProcessMetricsType {
+    int pid;
+    long long arrivalTime;
+    long long firstRunTime;
+    long long endTime;
+    long long readyTime;
+    long long cpuTime;
+    long long ioTime;
+    int preemptCount;
+} ProcessMetricsType;
+
+// per process values that are summarized over a run, in the order they are displayed and exported
+typedef enum {
+    METRIC_TURNAROUND,
+    METRIC_RESPONSE,
+    METRIC_READY,
+    METRIC_CPU,
+    METRIC_IO,
+    METRIC_PREEMPTIONS,
+    METRIC_COUNT
+} ProcessMetricCode;
+
+/**
+ * Mean and 95th percentile of one metric over the processes of a run
+ */
+typedef struct MetricSummaryType {
+    double mean;
+    long long p95;
+} MetricSummaryType;
+
+/**
+ * Accounting of every exited process of a run, in the order they exited
+ */
+typedef struct SimMetricsType {
+    ProcessMetricsType *processes;
+    int count;
+    int capacity;
+    long long contextSwitchCount;
+} SimMetricsType;
+
+// function prototypes
+SimMetricsType *createSimMetrics();
+SimMetricsType *clearSimMetrics(SimMetricsType *metrics);
+void addProcessMetrics(SimMetricsType *metrics, ProcessMetricsType *process);
+void summarizeProcessMetrics(SimMetricsType *metrics, MetricSummaryType *turnaround, MetricSummaryType *waiting,
+                             MetricSummaryType *response);
+long long getProcessMetric(ProcessMetricsType *process, int metricCode);
+MetricSummaryType summarizeMetric(SimMetricsType *metrics, int metricCode);
+void displayProcessMetrics(SimMetricsType *metrics);
+void getMetricsFileName(char *logFileName, int metricsCode, char *fileName);
+Boolean writeProcessMetrics(SimMetricsType *metrics, int metricsCode, char *fileName);
+
+#endif
@@ -0,0 +1,163 @@
+#include "simoverhead.h"
+
+/**
+ * Find the bucket of a value
+ * @param value non negative value
+ * @return bucket index
+ */
+static int getHistogramBucket(long long value) {
+    unsigned long long unsignedValue = (unsigned long long) value;
+    if (unsignedValue < HISTOGRAM_SUB_COUNT) {
+        return (int) unsignedValue;
+    }
+    // bucket by the top HISTOGRAM_SUB_BITS + 1 bits of the value
+    int shift = 63 - __builtin_clzll(unsignedValue) - HISTOGRAM_SUB_BITS;
+    return (shift + 1) * HISTOGRAM_SUB_COUNT + (int) ((unsignedValue >> shift) - HISTOGRAM_SUB_COUNT);
+}
+
+/**
+ * Get the highest value that falls into a bucket
+ * @param bucket bucket index
+ * @return highest value of the bucket
+ */
+static long long getBucketHighest(int bucket) {
+    if (bucket < HISTOGRAM_SUB_COUNT) {
+        return bucket;
+    }
+    int shift = bucket / HISTOGRAM_SUB_COUNT - 1;
+    long long lowest = (long long) (bucket % HISTOGRAM_SUB_COUNT + HISTOGRAM_SUB_COUNT) << shift;
+    return lowest + ((1LL << shift) - 1);
+}
+
+/**
+ * Record a value
+ * @param histogram histogram
+ * @param value value, negative values are recorded as 0
+ */
+void recordHistogram(HistogramType *histogram, long long value) {
+    if (value < 0) {
+        value = 0;
+    }
+    histogram->counts[getHistogramBucket(value)]++;
+    if (histogram->count == 0 || value < histogram->min) {
+        histogram->min = value;
+    }
+    if (value > histogram->max) {
+        histogram->max = value;
+    }
+    histogram->count++;
+    histogram->total += value;
+}
+
+/**
+ * Add every value of one histogram to another
+ * @param destination histogram added to
+ * @param source histogram added
+ */
+void mergeHistogram(HistogramType *destination, HistogramType *source) {
+    if (source->count == 0) {
+        return;
+    }
+    for (int bucket = 0; bucket < HISTOGRAM_BUCKET_COUNT; bucket++) {
+        destination->counts[bucket] += source->counts[bucket];
+    }
+    if (destination->count == 0 || source->min < destination->min) {
+        destination->min = source->min;
+    }
+    if (source->max > destination->max) {
+        destination->max = source->max;
+    }
+    destination->count += source->count;
+    destination->total += source->total;
+}
+
+/**
+ * Get the value at a percentile, as the highest value of its bucket, never above the largest value recorded
+ * @param histogram histogram
+ * @param percentile percentile, from 0 to 100
+ * @return value at the percentile, 0 for an empty histogram
+ */
+long long getHistogramPercentile(HistogramType *histogram, double percentile) {
+    long long rank = (long long) (percentile / 100.0 * histogram->count + 0.999999);
+    long long seen = 0;
+    if (rank < 1) {
+        rank = 1;
+    }
+    for (int bucket = 0; bucket < HISTOGRAM_BUCKET_COUNT && histogram->count > 0; bucket++) {
+        seen += histogram->counts[bucket];
+        if (seen >= rank) {
+            long long highest = getBucketHighest(bucket);
+            return highest < histogram->max ? highest : histogram->max;
+        }
+    }
+    return histogram->max;
+}
+
+/**
+ * Add every sleep of one set of timer stats to another
+ * @param destination timer stats added to
+ * @param source timer stats added
+ */
+void mergeTimerStats(TimerStatsType *destination, TimerStatsType *source) {
+    mergeHistogram(&destination->requested, &source->requested);
+    mergeHistogram(&destination->actual, &source->actual);
+    mergeHistogram(&destination->late, &source->late);
+    mergeHistogram(&destination->overdue, &source->overdue);
+}
+
+/**
+ * Create empty overhead histograms
+ * @return new overhead histograms
+ */
+SimOverheadType *createSimOverhead() {
+    return calloc(1, sizeof(SimOverheadType));
+}
+
+/**
+ * Free overhead histograms
+ * @param overhead overhead histograms, or NULL
+ * @return NULL
+ */
+SimOverheadType *clearSimOverhead(SimOverheadType *overhead) {
+    free(overhead);
+    return NULL;
+}
+
+/**
+ * Display one histogram as a row of the overhead table, in microseconds
+ * @param name row name
+ * @param histogram histogram
+ */
+static void displayHistogramRow(char *name, HistogramType *histogram) {
+    double percentiles[] = {50.0, 90.0, 99.0, 99.9};
+    printf("%-22s %9lld %10.1f %10.1f", name, histogram->count,
+           histogram->count > 0 ? histogram->min / 1000.0 : 0.0,
+           histogram->count > 0 ? (double) histogram->total / histogram->count / 1000.0 : 0.0);
+    for (int index = 0; index < 4; index++) {
+        printf(" %10.1f", getHistogramPercentile(histogram, percentiles[index]) / 1000.0);
+    }
+    printf(" %10.1f\n", histogram->max / 1000.0);
+}
+
+/**
+ * Display every overhead histogram. A high wake up lateness, many overdue waits or slow thread starts
+ * mean host load is distorting the simulated timings.
+ * @param overhead overhead histograms
+ */
+void displaySimOverhead(SimOverheadType *overhead) {
+    printf("\nSimulator Overhead (us)\n-----------------------\n");
+    printf("%-22s %9s %10s %10s %10s %10s %10s %10s %10s\n", "", "count", "min", "mean", "p50", "p90", "p99",
+           "p99.9", "max");
+    displayHistogramRow("clock wait requested", &overhead->clockWaits.requested);
+    displayHistogramRow("clock wait actual", &overhead->clockWaits.actual);
+    displayHistogramRow("clock wait late", &overhead->clockWaits.late);
+    displayHistogramRow("clock wait overdue", &overhead->clockWaits.overdue);
+    displayHistogramRow("device wait requested", &overhead->deviceWaits.requested);
+    displayHistogramRow("device wait actual", &overhead->deviceWaits.actual);
+    displayHistogramRow("device wait late", &overhead->deviceWaits.late);
+    displayHistogramRow("device wait overdue", &overhead->deviceWaits.overdue);
+    displayHistogramRow("thread start", &overhead->threadStart);
+    displayHistogramRow("thread join", &overhead->threadJoin);
+    displayHistogramRow("log call", &overhead->logCall);
+    displayHistogramRow("log write", &overhead->logWrite);
+}
@@ -0,0 +1,61 @@
+#ifndef SIMOVERHEAD_H
+#define SIMOVERHEAD_H
+
+#include "datatypes.h"
+
+// GLOBAL CONSTANTS
+// every power of two is split into this many buckets, so a recorded value is off by at most 1 part in 32
+#define HISTOGRAM_SUB_BITS 5
+#define HISTOGRAM_SUB_COUNT (1 << HISTOGRAM_SUB_BITS)
+#define HISTOGRAM_BUCKET_COUNT ((64 - HISTOGRAM_SUB_BITS) * HISTOGRAM_SUB_COUNT)
+
+/**
+ * Log-linear histogram of non negative values, in the manner of an HDR histogram:
+ * values below HISTOGRAM_SUB_COUNT get a bucket each, larger ones share a bucket with values
+ * within 1/HISTOGRAM_SUB_COUNT of them. Recording is a few shifts and an add, with no allocation.
+ */
+typedef struct HistogramType {
+    long long counts[HISTOGRAM_BUCKET_COUNT];
+    long long count;
+    long long min;
+    long long max;
+    long long total;
+} HistogramType;
+
+/**
+ * Timing of sleeps to a deadline, in nanoseconds: how long each one asked for,
+ * how long it took and how much longer than asked that was.
+ * Deadlines that had already passed when the sleep was called ask for nothing,
+ * how far behind they were is kept in overdue instead.
+ */
+typedef struct TimerStatsType {
+    HistogramType requested;
+    HistogramType actual;
+    HistogramType late;
+    HistogramType overdue;
+} TimerStatsType;
+
+/**
+ * How much of a run went to the simulator itself, in nanoseconds.
+ * Every histogram is only recorded by one thread while the run goes on,
+ * device worker timings are kept per worker and merged once the workers are joined.
+ */
+typedef struct SimOverheadType {
+    TimerStatsType clockWaits;
+    TimerStatsType deviceWaits;
+    HistogramType threadStart;
+    HistogramType threadJoin;
+    HistogramType logCall;
+    HistogramType logWrite;
+} SimOverheadType;
+
+// function prototypes
+void recordHistogram(HistogramType *histogram, long long value);
+void mergeHistogram(HistogramType *destination, HistogramType *source);
+long long getHistogramPercentile(HistogramType *histogram, double percentile);
+void mergeTimerStats(TimerStatsType *destination, TimerStatsType *source);
+SimOverheadType *createSimOverhead();
+SimOverheadType *clearSimOverhead(SimOverheadType *overhead);
+void displaySimOverhead(SimOverheadType *overhead);
+
+#endif
@@ -0,0 +1,212 @@
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "simtrace.h"
+
+const int TRACE_VERSION = 2;
+
+static const char TRACE_MAGIC[8] = {'S', 'I', 'M', 'T', 'R', 'A', 'C', 'E'};
+
+// the trace file is extended and remapped in steps of this many bytes
+#define TRACE_GROW_SIZE (8LL << 20)
+
+/**
+ * Map a larger part of the trace file, extending the file first
+ * @param writer trace writer
+ * @return False if the file could not be extended or mapped
+ */
+static Boolean growTraceMapping(TraceWriterType *writer) {
+    long long newSize = writer->mappedSize + TRACE_GROW_SIZE;
+    if (writer->mapping != NULL) {
+        munmap(writer->mapping, (size_t) writer->mappedSize);
+        writer->mapping = NULL;
+    }
+    if (ftruncate(writer->fileDescriptor, (off_t) newSize) != 0) {
+        return False;
+    }
+    void *mapping = mmap(NULL, (size_t) newSize, PROT_READ | PROT_WRITE, MAP_SHARED, writer->fileDescriptor, 0);
+    if (mapping == MAP_FAILED) {
+        return False;
+    }
+    writer->mapping = mapping;
+    writer->mappedSize = newSize;
+    return True;
+}
+
+/**
+ * Create a trace file, pre-sized and mapped for writing
+ * @param fileName trace file name
+ * @return new trace writer, NULL if the file could not be created
+ */
+TraceWriterType *createTraceWriter(char *fileName) {
+    TraceWriterType *writer = calloc(1, sizeof(TraceWriterType));
+    writer->fileDescriptor = open(fileName, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (writer->fileDescriptor < 0 || growTraceMapping(writer) == False) {
+        if (writer->fileDescriptor >= 0) {
+            close(writer->fileDescriptor);
+        }
+        free(writer);
+        return NULL;
+    }
+    writer->usedSize = sizeof(TraceHeaderType);
+    return writer;
+}
+
+/**
+ * Write the header, cut the file down to the records written and close it
+ * @param writer trace writer, or NULL
+ * @return NULL
+ */
+TraceWriterType *closeTraceWriter(TraceWriterType *writer) {
+    if (writer == NULL) {
+        return NULL;
+    }
+    if (writer->mapping != NULL) {
+        TraceHeaderType *header = (TraceHeaderType *) writer->mapping;
+        memcpy(header->magic, TRACE_MAGIC, sizeof(TRACE_MAGIC));
+        header->version = TRACE_VERSION;
+        header->recordSize = (int) sizeof(TraceRecordType);
+        header->recordCount = writer->recordCount;
+        munmap(writer->mapping, (size_t) writer->mappedSize);
+        if (ftruncate(writer->fileDescriptor, (off_t) writer->usedSize) != 0) {
+            printf("Trace file could not be truncated, it ends in unused space\n");
+        }
+    }
+    close(writer->fileDescriptor);
+    free(writer);
+    return NULL;
+}
+
+/**
+ * Append one record to the trace mapping
+ * @param writer trace writer
+ * @param traceRecord record to append
+ */
+static void appendTraceRecord(TraceWriterType *writer, TraceRecordType *traceRecord) {
+    if (writer->mapping == NULL) {
+        return;
+    }
+    if (writer->usedSize + (long long) sizeof(TraceRecordType) > writer->mappedSize
+        && growTraceMapping(writer) == False) {
+        printf("Trace file could not be extended, trace cut short\n");
+        return;
+    }
+    memcpy(writer->mapping + writer->usedSize, traceRecord, sizeof(TraceRecordType));
+    writer->usedSize += sizeof(TraceRecordType);
+    writer->recordCount++;
+}
+
+/**
+ * Write a log record to the trace
+ * @param writer trace writer
+ * @param record log record
+ */
+void writeTraceRecord(TraceWriterType *writer, LogRecordType *record) {
+    TraceRecordType traceRecord;
+    long long delta = record->time - writer->lastTime;
+
+    // a gap of over an hour, or a step back in time, takes an extra record with the whole delta
+    if (delta < 0 || delta > 0xFFFFFFFFLL) {
+        memset(&traceRecord, 0, sizeof(TraceRecordType));
+        traceRecord.code = TRACE_TIME_EXTEND_CODE;
+        traceRecord.timeDelta = (unsigned int) ((unsigned long long) delta & 0xFFFFFFFFULL);
+        traceRecord.pid = (int) (delta >> 32);
+        appendTraceRecord(writer, &traceRecord);
+        writer->lastTime += delta;
+        delta = 0;
+    }
+    // op numbers take an extra record in front of the one they belong to
+    if (record->intArg2 != 0 || record->intArg3 != 0) {
+        memset(&traceRecord, 0, sizeof(TraceRecordType));
+        traceRecord.code = TRACE_OP_ARGS_CODE;
+        traceRecord.timeDelta = (unsigned int) record->intArg2;
+        traceRecord.pid = record->intArg3;
+        appendTraceRecord(writer, &traceRecord);
+    }
+    traceRecord.timeDelta = (unsigned int) delta;
+    traceRecord.pid = record->pid;
+    traceRecord.code = (unsigned char) record->code;
+    traceRecord.argCode = (unsigned char) record->argCode;
+    traceRecord.inOutCode = (unsigned char) record->inOutCode;
+    traceRecord.reserved = 0;
+    appendTraceRecord(writer, &traceRecord);
+    writer->lastTime += delta;
+}
+
+/**
+ * Open a trace file for decoding
+ * @param fileName trace file name
+ * @return new trace reader, NULL if the file is missing or not a trace from this version or an earlier one
+ */
+TraceReaderType *openTraceReader(char *fileName) {
+    FileBufferType *filePtr = openFileBuffer(fileName);
+    if (filePtr == NULL) {
+        return NULL;
+    }
+    TraceHeaderType *header = (TraceHeaderType *) filePtr->data;
+    if (filePtr->size < (long long) sizeof(TraceHeaderType)
+        || memcmp(header->magic, TRACE_MAGIC, sizeof(TRACE_MAGIC)) != 0
+        || header->version < 1 || header->version > TRACE_VERSION
+        || header->recordSize != (int) sizeof(TraceRecordType)
+        || (long long) sizeof(TraceHeaderType) + header->recordCount * (long long) sizeof(TraceRecordType)
+           > filePtr->size) {
+        closeFileBuffer(filePtr);
+        return NULL;
+    }
+    TraceReaderType *reader = calloc(1, sizeof(TraceReaderType));
+    reader->filePtr = filePtr;
+    reader->recordCount = header->recordCount;
+    return reader;
+}
+
+/**
+ * Close a trace reader
+ * @param reader trace reader, or NULL
+ * @return NULL
+ */
+TraceReaderType *closeTraceReader(TraceReaderType *reader) {
+    if (reader != NULL) {
+        closeFileBuffer(reader->filePtr);
+        free(reader);
+    }
+    return NULL;
+}
+
+/**
+ * Decode the next log record of a trace
+ * @param reader trace reader
+ * @param record output for the log record, with its absolute time
+ * @return False at the end of the trace
+ */
+Boolean readTraceRecord(TraceReaderType *reader, LogRecordType *record) {
+    TraceRecordType traceRecord;
+
+    while (reader->nextRecord < reader->recordCount) {
+        memcpy(&traceRecord, reader->filePtr->data + sizeof(TraceHeaderType)
+               + reader->nextRecord * sizeof(TraceRecordType), sizeof(TraceRecordType));
+        reader->nextRecord++;
+        if (traceRecord.code == TRACE_TIME_EXTEND_CODE) {
+            reader->lastTime += (long long) (((unsigned long long) (unsigned int) traceRecord.pid << 32)
+                                             | traceRecord.timeDelta);
+            continue;
+        }
+        if (traceRecord.code == TRACE_OP_ARGS_CODE) {
+            reader->intArg2 = (int) traceRecord.timeDelta;
+            reader->intArg3 = traceRecord.pid;
+            continue;
+        }
+        reader->lastTime += traceRecord.timeDelta;
+        record->time = reader->lastTime;
+        record->code = traceRecord.code;
+        record->pid = traceRecord.pid;
+        record->argCode = traceRecord.argCode;
+        record->inOutCode = traceRecord.inOutCode;
+        record->intArg2 = reader->intArg2;
+        record->intArg3 = reader->intArg3;
+        reader->intArg2 = 0;
+        reader->intArg3 = 0;
+        return True;
+    }
+    return False;
+}
@@ -0,0 +1,71 @@
+#ifndef SIMTRACE_H
+#define SIMTRACE_H
+
+#include "datatypes.h"
+#include "StringUtils.h"
+#include "simlog.h"
+
+// GLOBAL CONSTANTS
+extern const int TRACE_VERSION;
+
+// marks a record that only carries a time delta that does not fit an unsigned 32 bit field
+#define TRACE_TIME_EXTEND_CODE 255
+
+// marks a record that only carries the op numbers of the record after it
+#define TRACE_OP_ARGS_CODE 254
+
+/**
+ * Header at the start of a binary trace file
+ */
+typedef struct TraceHeaderType {
+    char magic[8];
+    int version;
+    int recordSize;
+    long long recordCount;
+} TraceHeaderType;
+
+/**
+ * One log record in a trace, its time is stored as the delta to the record before it
+ */
+typedef struct TraceRecordType {
+    unsigned int timeDelta;
+    int pid;
+    unsigned char code;
+    unsigned char argCode;
+    unsigned char inOutCode;
+    unsigned char reserved;
+} TraceRecordType;
+
+/**
+ * Trace file written through a shared mapping that grows in large steps
+ */
+typedef struct TraceWriterType {
+    int fileDescriptor;
+    char *mapping;
+    long long mappedSize;
+    long long usedSize;
+    long long recordCount;
+    long long lastTime;
+} TraceWriterType;
+
+/**
+ * Trace file being decoded
+ */
+typedef struct TraceReaderType {
+    FileBufferType *filePtr;
+    long long recordCount;
+    long long nextRecord;
+    long long lastTime;
+    int intArg2;
+    int intArg3;
+} TraceReaderType;
+
+// function prototypes
+TraceWriterType *createTraceWriter(char *fileName);
+TraceWriterType *closeTraceWriter(TraceWriterType *writer);
+void writeTraceRecord(TraceWriterType *writer, LogRecordType *record);
+TraceReaderType *openTraceReader(char *fileName);
+TraceReaderType *closeTraceReader(TraceReaderType *reader);
+Boolean readTraceRecord(TraceReaderType *reader, LogRecordType *record);
+
+#endif
@@ -1,279 +1,1014 @@
 #include "simulator.h"
 
+const int STREAM_PROCESS_WINDOW = 64;
+
+/**
+ * Log an event of a process
+ * @param sim simulator state
+ * @param time simulation time of the event
+ * @param code LogEventCode of the event
+ * @param pid process the event belongs to
+ * @param op op code of a device or memory event, NULL for others
+ */
+void logProcessEvent(SimulatorType *sim, long long time, int code, int pid, OpCodeType *op) {
+    if (sim->overhead == NULL) {
+        logSimEvent(sim->logger, time, code, pid, op);
+        return;
+    }
+    long long startTime = getMonotonicNanoTime();
+    logSimEvent(sim->logger, time, code, pid, op);
+    recordHistogram(&sim->overhead->logCall, getMonotonicNanoTime() - startTime);
+}
+
 /**
- * Get the difference between the current time and the start time
- * @param start start time
- * @return time diff
+ * Get the time an op code takes to run
+ * @param configDataPtr Config Data
+ * @param op op code
+ * @return run time in microseconds, 0 for op codes that take no time
+ */
+long long getOpTime(ConfigDataType *configDataPtr, OpCodeType *op) {
+    if (op->commandCode == CMD_CPU && op->argCode == ARG_PROCESS) {
+        return op->intArg2 * configDataPtr->procCycleRate * 1000LL;
+    }
+    if (op->commandCode == CMD_DEV) {
+        return op->intArg2 * configDataPtr->ioCycleRate * 1000LL;
+    }
+    return 0;
+}
+
+/**
+ * Get the time a process still needs to run, from its current op up to its app end
+ * @param configDataPtr Config Data
+ * @param process process control block
+ * @return remaining run time in microseconds
  */
-struct timeval timeDiff(struct timeval start) {
-    struct timeval end;
-    gettimeofday(&end, NULL);
-    long secDiff;
-    long usecDiff;
+long long getRemainingTime(ConfigDataType *configDataPtr, ProcessControlBlock *process) {
+    long long remainingTime = 0;
+    for (OpCodeType *op = process->currentOp; op < process->endOp; op++) {
+        remainingTime += getOpTime(configDataPtr, op);
+    }
+    return remainingTime;
+}
 
-    secDiff = end.tv_sec - start.tv_sec;
-    usecDiff = end.tv_usec - start.tv_usec;
+/**
+ * Create the process control blocks from the process op ranges of the program.
+ * The blocks are allocated as one array indexed by process id.
+ * @param programPtr op code program
+ * @return array of process control blocks
+ */
+ProcessControlBlock *createProcessControlBlocks(OpProgramType *programPtr) {
+    int processCount = programPtr->processCount;
 
-    // wrap around
-    if (usecDiff < 0) {
-        usecDiff += 1000000;
-        secDiff--;
+    // no pcbs to allocate
+    if (processCount == 0) {
+        return NULL;
     }
 
-    end.tv_sec = secDiff;
-    end.tv_usec = usecDiff;
-    return end;
+    // allocate the pcbs, each one runs from the op after its app start up to its app end
+    ProcessControlBlock *pcb = calloc(processCount, sizeof(ProcessControlBlock));
+    for (int index = 0; index < processCount; index++) {
+        ProcessRangeType *range = &programPtr->processes[index];
+        pcb[index].id = index;
+        pcb[index].state = NEW;
+        pcb[index].currentOp = &programPtr->ops[range->startIndex + 1];
+        // a process without an app end runs to the end of the program
+        pcb[index].endOp = &programPtr->ops[range->endIndex >= 0 ? range->endIndex : programPtr->opCount - 1];
+        pcb[index].sliceEnd = -1;
+        pcb[index].readyIndex = READY_NOT_QUEUED;
+        pcb[index].core = -1;
+        pcb[index].lastCore = -1;
+    }
+    return pcb;
 }
 
 /**
- * run timer from Michael
+ * Create the process control block for a streamed process block
+ * @param block process block, owned by the pcb from now on
+ * @return new process control block
  */
-void runTimer(long milliSeconds) {
-    struct timeval startTime, endTime;
-    int startSec, startUSec, endSec, endUSec;
-    int uSecDiff, mSecDiff, secDiff, timeDiff;
-    gettimeofday(&startTime, NULL);
+ProcessControlBlock *createStreamedProcessControlBlock(ProcessBlockType *block) {
+    ProcessControlBlock *process = calloc(1, sizeof(ProcessControlBlock));
+    process->id = block->pid;
+    process->state = NEW;
+    process->currentOp = &block->ops[1];
+    process->endOp = &block->ops[block->opCount - 1];
+    process->sliceEnd = -1;
+    process->readyIndex = READY_NOT_QUEUED;
+    process->core = -1;
+    process->lastCore = -1;
+    process->block = block;
+    return process;
+}
 
-    startSec = startTime.tv_sec;
-    startUSec = startTime.tv_usec;
-    timeDiff = 0;
+/**
+ * Double the process table. Ids that differ in the old table size also differ in the new one,
+ * so moving the live processes over never collides.
+ * @param sim simulator state
+ */
+void growProcessTable(SimulatorType *sim) {
+    int oldSize = sim->processTableSize;
+    ProcessControlBlock **oldTable = sim->processTable;
+    sim->processTableSize = oldSize * 2;
+    sim->processTable = calloc(sim->processTableSize, sizeof(ProcessControlBlock *));
+    for (int index = 0; index < oldSize; index++) {
+        if (oldTable[index] != NULL) {
+            sim->processTable[oldTable[index]->id & (sim->processTableSize - 1)] = oldTable[index];
+        }
+    }
+    free(oldTable);
+}
 
-    while (timeDiff < milliSeconds) {
-        gettimeofday(&endTime, NULL);
+/**
+ * Find a live process by id
+ * @param sim simulator state
+ * @param pid process id
+ * @return process control block
+ */
+ProcessControlBlock *findProcess(SimulatorType *sim, int pid) {
+    return sim->processTable[pid & (sim->processTableSize - 1)];
+}
+
+/**
+ * Check if a scheduling code takes the cpu away from a running process
+ * @param scheduleCode cpu scheduling code
+ * @return True if cpu ops run in quantum slices and can be preempted
+ */
+Boolean isPreemptive(int scheduleCode) {
+    return scheduleCode == CPU_SCHED_SRTF_P_CODE || scheduleCode == CPU_SCHED_FCFS_P_CODE
+           || scheduleCode == CPU_SCHED_RR_P_CODE;
+}
 
-        endSec = endTime.tv_sec;
-        endUSec = endTime.tv_usec;
-        uSecDiff = endUSec - startUSec;
+/**
+ * Check if a scheduling code dispatches READY processes from the ready ring instead of the ready queue
+ * @param scheduleCode cpu scheduling code
+ * @return True if processes are dispatched in the order they became ready
+ */
+Boolean usesReadyRing(int scheduleCode) {
+    return scheduleCode == CPU_SCHED_RR_P_CODE;
+}
+
+/**
+ * Get the key a process is ordered by in the ready queue.
+ * SJF-N and SRTF-P dispatch the process with the least remaining time first, everything else by process id,
+ * which is also the order processes arrive in.
+ * @param sim simulator state
+ * @param process process
+ * @param remainingTime remaining time of the process
+ * @return ready queue key
+ */
+long long getReadyKey(SimulatorType *sim, ProcessControlBlock *process, long long remainingTime) {
+    int scheduleCode = sim->configDataPtr->cpuSchedCode;
+    if (scheduleCode == CPU_SCHED_SJF_N_CODE || scheduleCode == CPU_SCHED_SRTF_P_CODE) {
+        return remainingTime;
+    }
+    return process->id;
+}
 
-        if (uSecDiff < 0) {
-            uSecDiff = uSecDiff + 1000000;
-            endSec = endSec - 1;
+/**
+ * Log a cpu op event of a process, naming the core it runs on when there is more than one
+ * @param sim simulator state
+ * @param time simulation time of the event
+ * @param code LOG_CPU_START, LOG_CPU_END or LOG_CPU_RESUME
+ * @param process running process
+ * @param core core the process runs on
+ */
+void logCpuEvent(SimulatorType *sim, long long time, int code, ProcessControlBlock *process, CoreType *core) {
+    if (sim->coreCount == 1) {
+        logProcessEvent(sim, time, code, process->id, NULL);
+        return;
+    }
+    OpCodeType coreOp = {process->id, CMD_CPU, IO_NONE, ARG_PROCESS, core->id, sim->coreCount, 0.0};
+    logProcessEvent(sim, time, code, process->id, &coreOp);
+}
+
+/**
+ * Get the number of processes waiting in the run queue of a core, leaving out the one running
+ * @param sim simulator state
+ * @param core core
+ * @return number of READY processes queued on the core
+ */
+int getWaitingCount(SimulatorType *sim, CoreType *core) {
+    if (usesReadyRing(sim->configDataPtr->cpuSchedCode) == True) {
+        return core->readyRing->count;
+    }
+    // a process from the ready queue stays queued while it runs
+    if (core->currentProcess != NULL && core->currentProcess->readyIndex != READY_NOT_QUEUED) {
+        return core->readyQueue->count - 1;
+    }
+    return core->readyQueue->count;
+}
+
+/**
+ * Add the busy time of the slice a core is running up to now
+ * @param sim simulator state
+ * @param core core that stops being busy
+ */
+void endBusyTime(SimulatorType *sim, CoreType *core) {
+    core->busyTime += getIdealTime(&sim->clock) - core->busyStart;
+    core->busy = False;
+}
+
+/**
+ * Take the cpu from the running process when a READY process comes before it in the run queue of its core:
+ * one with less time left under SRTF-P, one that arrived earlier under FCFS-P.
+ * A slice that is still running is cut short and the time it ran is charged to the process.
+ * The running process stays in the ready queue, so it only needs its key brought down to what it has left.
+ * @param sim simulator state
+ * @param core core of the running process
+ */
+void preemptRunningProcess(SimulatorType *sim, CoreType *core) {
+    ProcessControlBlock *process = core->currentProcess;
+    long long now = getIdealTime(&sim->clock);
+    long long elapsedTime = 0;
+    long long firstKey;
+    int firstPid;
+
+    if (process == NULL || isPreemptive(sim->configDataPtr->cpuSchedCode) == False
+        || usesReadyRing(sim->configDataPtr->cpuSchedCode) == True) {
+        return;
+    }
+    // a slice that ends right now finishes through its event
+    if (core->busy == True) {
+        if (process->sliceEnd <= now) {
+            return;
         }
+        // nothing has run yet while the process pays its migration penalty
+        elapsedTime = now > process->sliceStart ? now - process->sliceStart : 0;
+    }
+    long long remainingTime = process->remainingTime - elapsedTime;
+    updateReadyKey(core->readyQueue, &process->readyIndex, getReadyKey(sim, process, remainingTime));
+    peekReady(core->readyQueue, &firstPid, &firstKey);
+    if (firstPid == process->id) {
+        return;
+    }
 
-        mSecDiff = uSecDiff / 1000;
-        secDiff = (endSec - startSec) * 1000;
-        timeDiff = secDiff + mSecDiff;
+    long long logTime = getSimTime(&sim->clock);
+    if (core->busy == True) {
+        process->opTimeLeft -= elapsedTime;
+        process->remainingTime = remainingTime;
+        process->metrics.cpuTime += elapsedTime;
+        process->sliceEnd = -1;
+        // the part of the migration penalty that was not paid yet is not charged to the core
+        if (now < process->sliceStart) {
+            core->migrationTime -= process->sliceStart - now;
+        }
+        endBusyTime(sim, core);
+        logProcessEvent(sim, logTime, LOG_CPU_INTERRUPTED, process->id, NULL);
+    } else if (process->opTimeLeft > 0) {
+        logProcessEvent(sim, logTime, LOG_QUANTUM_TIMEOUT, process->id, NULL);
     }
+    process->state = READY;
+    process->readyStart = now;
+    process->metrics.preemptCount++;
+    core->currentProcess = NULL;
+    logProcessEvent(sim, logTime, LOG_PROCESS_PREEMPTED, process->id, NULL);
 }
 
 /**
- * Macro for logging to stdout and/or a file.
- * Make sure logS, logF, and logFile are defined before using this.
+ * Send the running process to the tail of the ready ring of its core when its quantum runs out
+ * in the middle of an op, RR-P only. With no other process READY on the core it keeps the core for another quantum.
+ * @param sim simulator state
+ * @param core core of the running process
  */
-#define LOGGER(...) \
-    if (logS) { printf(__VA_ARGS__); } \
-    if (logF) { fprintf(logFile, __VA_ARGS__); }
+void expireQuantum(SimulatorType *sim, CoreType *core) {
+    ProcessControlBlock *process = core->currentProcess;
+
+    if (process->opTimeLeft == 0 || isReadyRingEmpty(core->readyRing) == True) {
+        return;
+    }
+    long long logTime = getSimTime(&sim->clock);
+    logProcessEvent(sim, logTime, LOG_QUANTUM_TIMEOUT, process->id, NULL);
+    logProcessEvent(sim, logTime, LOG_PROCESS_PREEMPTED, process->id, NULL);
+    process->state = READY;
+    process->readyStart = getIdealTime(&sim->clock);
+    process->metrics.preemptCount++;
+    core->currentProcess = NULL;
+    pushReadyRing(core->readyRing, process->id);
+}
 
 /**
- * Create a linked list of process control blocks from the op code list
- * @param metaDataPtr op code list
- * @return linked list of process control blocks
+ * Choose the core a READY process is queued on. A process goes back to the core it was queued on before
+ * unless that core is taken while another one has nothing to do, a new process goes to the core with the fewest processes.
+ * @param sim simulator state
+ * @param process process that is ready to run
+ * @return core to queue the process on
  */
-ProcessControlBlock *createProcessControlBlocks(OpCodeType *metaDataPtr) {
-    int processCount = 0;
-    // get the amount of processes from the op code list
-    OpCodeType *currentOp = metaDataPtr;
-    while (currentOp != NULL) {
-        if (compareString(currentOp->command, "app") == STR_EQ
-            && compareString(currentOp->strArg1, "start") == STR_EQ) {
-            processCount++;
+CoreType *chooseCore(SimulatorType *sim, ProcessControlBlock *process) {
+    if (process->core >= 0 && sim->cores[process->core].currentProcess == NULL) {
+        return &sim->cores[process->core];
+    }
+    CoreType *chosenCore = &sim->cores[0];
+    int chosenLoad = -1;
+    for (int index = 0; index < sim->coreCount; index++) {
+        CoreType *core = &sim->cores[index];
+        int load = getWaitingCount(sim, core) + (core->currentProcess != NULL ? 1 : 0);
+        if (chosenLoad < 0 || load < chosenLoad) {
+            chosenCore = core;
+            chosenLoad = load;
         }
-        currentOp = currentOp->nextNode;
     }
+    if (process->core >= 0 && chosenLoad > 0) {
+        return &sim->cores[process->core];
+    }
+    return chosenCore;
+}
 
-    // no pcbs to allocate
-    if (processCount == 0) {
+/**
+ * Move a process to the READY state and queue it on a core
+ * @param sim simulator state
+ * @param process process that is ready to run
+ */
+void setProcessReady(SimulatorType *sim, ProcessControlBlock *process) {
+    CoreType *core = chooseCore(sim, process);
+    process->state = READY;
+    process->readyStart = getIdealTime(&sim->clock);
+    process->core = core->id;
+    if (usesReadyRing(sim->configDataPtr->cpuSchedCode) == True) {
+        pushReadyRing(core->readyRing, process->id);
+        return;
+    }
+    pushReady(core->readyQueue, getReadyKey(sim, process, process->remainingTime), process->id, &process->readyIndex);
+    preemptRunningProcess(sim, core);
+}
+
+/**
+ * Move a new process to the READY state
+ * @param sim simulator state
+ * @param process new process
+ */
+void admitProcess(SimulatorType *sim, ProcessControlBlock *process) {
+    // the table only holds live processes, so it only grows with the spread of their ids
+    while (findProcess(sim, process->id) != NULL) {
+        growProcessTable(sim);
+    }
+    sim->processTable[process->id & (sim->processTableSize - 1)] = process;
+    sim->processCount++;
+    process->remainingTime = getRemainingTime(sim->configDataPtr, process);
+    process->metrics.pid = process->id;
+    process->metrics.arrivalTime = getIdealTime(&sim->clock);
+    process->metrics.firstRunTime = -1;
+
+    logProcessEvent(sim, getSimTime(&sim->clock), LOG_PROCESS_READY, process->id, NULL);
+    setProcessReady(sim, process);
+}
+
+/**
+ * Remove an exited process from the process table, freeing it if it was streamed
+ * @param sim simulator state
+ * @param process exited process
+ */
+void releaseProcess(SimulatorType *sim, ProcessControlBlock *process) {
+    sim->processTable[process->id & (sim->processTableSize - 1)] = NULL;
+
+    // pcbs of a loaded program live in one array
+    if (process->block != NULL) {
+        clearProcessBlock(process->block);
+        free(process);
+    }
+}
+
+/**
+ * Admit streamed processes until the process window is full or the stream runs out.
+ * Waiting for the parser does not move the simulation clock, so a virtual time run
+ * only depends on the metadata, not on how fast it is parsed.
+ * @param sim simulator state
+ * @return True while there are processes left to run
+ */
+Boolean admitProcesses(SimulatorType *sim) {
+    char endStateMsg[MAX_STR_LEN];
+    while (sim->streamOpen == True && sim->processCount - sim->exitCount < STREAM_PROCESS_WINDOW) {
+        ProcessBlockType *block = takeProcessBlock(sim->stream);
+        if (block == NULL) {
+            sim->streamOpen = False;
+            sim->streamFailed = getMetaDataStreamResult(sim->stream, endStateMsg) == False;
+            break;
+        }
+        admitProcess(sim, createStreamedProcessControlBlock(block));
+    }
+    // stop the run on corrupt metadata, the driver reports the error
+    return sim->streamFailed == False && sim->exitCount < sim->processCount;
+}
+
+/**
+ * Move a READY process from the core with the most of them waiting onto an idle core with none.
+ * Under RR-P the one that has waited longest goes, otherwise the first one after the running process.
+ * @param sim simulator state
+ * @param core idle core
+ */
+void stealProcess(SimulatorType *sim, CoreType *core) {
+    CoreType *victim = NULL;
+    int victimCount = 0;
+    long long key = 0;
+    int pid;
+
+    for (int index = 0; index < sim->coreCount; index++) {
+        int waitingCount = getWaitingCount(sim, &sim->cores[index]);
+        if (waitingCount > victimCount) {
+            victim = &sim->cores[index];
+            victimCount = waitingCount;
+        }
+    }
+    if (victim == NULL || victim == core) {
+        return;
+    }
+    if (usesReadyRing(sim->configDataPtr->cpuSchedCode) == True) {
+        popReadyRing(victim->readyRing, &pid);
+        pushReadyRing(core->readyRing, pid);
+        findProcess(sim, pid)->core = core->id;
+    } else {
+        peekReadyExcept(victim->readyQueue, victim->currentProcess != NULL ? victim->currentProcess->id : -1,
+                        &pid, &key);
+        ProcessControlBlock *process = findProcess(sim, pid);
+        removeReady(victim->readyQueue, &process->readyIndex);
+        pushReady(core->readyQueue, key, pid, &process->readyIndex);
+        process->core = core->id;
+    }
+    core->stealCount++;
+}
+
+/**
+ * Select the next process to run on a core, stealing one from another core when its own run queue is empty.
+ * A process from the ready ring leaves it, a process from the ready queue stays queued while it runs,
+ * until it blocks or exits.
+ * @param sim simulator state
+ * @param core idle core
+ * @return selected process, NULL if no process is READY
+ */
+ProcessControlBlock *selectProcess(SimulatorType *sim, CoreType *core) {
+    long long key;
+    int pid;
+    if (sim->coreCount > 1 && getWaitingCount(sim, core) == 0) {
+        stealProcess(sim, core);
+    }
+    if (usesReadyRing(sim->configDataPtr->cpuSchedCode) == True) {
+        if (popReadyRing(core->readyRing, &pid) == False) {
+            return NULL;
+        }
+    } else if (peekReady(core->readyQueue, &pid, &key) == False) {
         return NULL;
     }
+    return findProcess(sim, pid);
+}
 
-    // allocate the pcbs
-    struct ProcessControlBlock *head = calloc(1, sizeof(struct ProcessControlBlock));
-    struct ProcessControlBlock *current = head;
-    for (int index = 0; index < processCount; index++) {
-        current->id = index;
-        current->state = NEW;
-        if (index < processCount - 1) {
-            current->next = calloc(1, sizeof(struct ProcessControlBlock));
-            current = current->next;
+/**
+ * Dispatch the next READY process on an idle core.
+ * Running a different process than the one the core ran last counts as a context switch.
+ * @param sim simulator state
+ * @param core idle core
+ */
+void dispatchProcess(SimulatorType *sim, CoreType *core) {
+    ProcessControlBlock *process = selectProcess(sim, core);
+    if (process == NULL) {
+        return;
+    }
+    long long now = getIdealTime(&sim->clock);
+    process->metrics.readyTime += now - process->readyStart;
+    if (process->metrics.firstRunTime < 0) {
+        process->metrics.firstRunTime = now;
+    }
+    if (core->lastPid >= 0 && core->lastPid != process->id) {
+        sim->metrics->contextSwitchCount++;
+    }
+    core->lastPid = process->id;
+    core->currentProcess = process;
+    sim->cpuIdle = False;
+    process->state = RUNNING;
+    logProcessEvent(sim, getSimTime(&sim->clock), LOG_PROCESS_RUNNING, process->id, NULL);
+    // a preempted process picks its cpu op up where it left off
+    if (process->opTimeLeft > 0) {
+        logCpuEvent(sim, getSimTime(&sim->clock), LOG_CPU_RESUME, process, core);
+    }
+}
+
+/**
+ * Take a process that stops running out of the ready queue of its core, if it is in it
+ * @param sim simulator state
+ * @param process process that blocks or exits
+ */
+void unqueueProcess(SimulatorType *sim, ProcessControlBlock *process) {
+    if (process->readyIndex != READY_NOT_QUEUED) {
+        removeReady(sim->cores[process->core].readyQueue, &process->readyIndex);
+    }
+}
+
+/**
+ * Finish a device op on its interrupt and return its process from BLOCKED to the READY state
+ * @param sim simulator state
+ * @param pid process that issued the op
+ * @param op dev op code
+ */
+void completeDeviceOp(SimulatorType *sim, int pid, OpCodeType *op) {
+    ProcessControlBlock *process = findProcess(sim, pid);
+    long long logTime = getSimTime(&sim->clock);
+    sim->pendingDeviceOps--;
+    process->metrics.ioTime += getIdealTime(&sim->clock) - process->blockStart;
+    logProcessEvent(sim, logTime, LOG_IO_END, process->id, op);
+    logProcessEvent(sim, logTime, LOG_PROCESS_UNBLOCKED, process->id, NULL);
+    setProcessReady(sim, process);
+}
+
+/**
+ * Handle every interrupt the device workers have posted, measuring how late each one is handled
+ * @param sim simulator state
+ */
+void handleInterrupts(SimulatorType *sim) {
+    InterruptType interrupt;
+    while (takeDeviceCompletion(sim->devicePool, &interrupt) == True) {
+        advanceSimClock(&sim->clock, interrupt.dueTime);
+        long long latency = getSimTime(&sim->clock) - interrupt.dueTime;
+        sim->interruptCount++;
+        sim->totalInterruptLatency += latency;
+        sim->totalPostLatency += interrupt.postTime - interrupt.dueTime;
+        if (latency > sim->maxInterruptLatency) {
+            sim->maxInterruptLatency = latency;
         }
+        completeDeviceOp(sim, interrupt.pid, interrupt.op);
     }
-    return head;
 }
 
 /**
- * Select a process from the list of PCBs using the scheduling code
+ * Display how late device interrupts were handled after their op was due to finish
+ * @param sim simulator state
  */
-ProcessControlBlock *selectProcess(int scheduleCode, ProcessControlBlock *pcb) {
-    if (scheduleCode == CPU_SCHED_FCFS_N_CODE) {
-        ProcessControlBlock *currentPcb = pcb;
-        while (currentPcb != NULL) {
-            if (currentPcb->state == READY) {
-                return currentPcb;
-            }
-            currentPcb = currentPcb->next;
+void displayInterruptLatency(SimulatorType *sim) {
+    if (sim->interruptCount == 0) {
+        return;
+    }
+    printf("Interrupt latency: max %lld us, mean %lld us over %lld interrupts, mean %lld us of it before posting\n",
+           sim->maxInterruptLatency, sim->totalInterruptLatency / sim->interruptCount, sim->interruptCount,
+           sim->totalPostLatency / sim->interruptCount);
+}
+
+/**
+ * Display how busy every core was over the run, when there is more than one
+ * @param sim simulator state
+ */
+void displayCoreUtilization(SimulatorType *sim) {
+    long long runTime = getIdealTime(&sim->clock);
+    if (sim->coreCount == 1) {
+        return;
+    }
+    for (int index = 0; index < sim->coreCount; index++) {
+        CoreType *core = &sim->cores[index];
+        printf("Core %d: %.2f%% busy, %.2f%% of it migration penalty, %d migrations in, %d processes stolen\n",
+               core->id, runTime > 0 ? 100.0 * core->busyTime / runTime : 0.0,
+               core->busyTime > 0 ? 100.0 * core->migrationTime / core->busyTime : 0.0,
+               core->migrationCount, core->stealCount);
+    }
+}
+
+/**
+ * Display the accounting of every process when the config asks for it,
+ * and write it as CSV or JSON next to the log file
+ * @param sim simulator state
+ */
+void displayRunMetrics(SimulatorType *sim) {
+    ConfigDataType *configDataPtr = sim->configDataPtr;
+    char metricsFileName[MAX_STR_LEN];
+    if (configDataPtr->metricsCode == METRICS_NONE_CODE) {
+        return;
+    }
+    displayProcessMetrics(sim->metrics);
+    if (configDataPtr->metricsCode == METRICS_CSV_CODE || configDataPtr->metricsCode == METRICS_JSON_CODE) {
+        getMetricsFileName(configDataPtr->logToFileName, configDataPtr->metricsCode, metricsFileName);
+        if (writeProcessMetrics(sim->metrics, configDataPtr->metricsCode, metricsFileName) == True) {
+            printf("Process metrics written to %s\n", metricsFileName);
+        } else {
+            printf("Process metrics could not be written to %s\n", metricsFileName);
         }
     }
-    return NULL;
 }
 
 /**
- * Main method for the timer thread
+ * End the running process, freeing its memory
+ * @param sim simulator state
+ * @param process running process
+ * @param endCode LOG_PROCESS_ENDED when it reached its app end, LOG_SEGFAULT when a memory op failed
+ * @param logTime simulation time the process ended at
  */
-void *timerThread(void *args) {
-    long *time = (long *) args;
-    runTimer(*time);
-    return 0;
+void exitProcess(SimulatorType *sim, ProcessControlBlock *process, int endCode, long long logTime) {
+    unqueueProcess(sim, process);
+    freeProcessMemory(sim->memory, &process->segments);
+    process->state = EXIT;
+    sim->exitCount++;
+    if (endCode == LOG_SEGFAULT) {
+        sim->segfaultCount++;
+    }
+    process->metrics.endTime = getIdealTime(&sim->clock);
+    addProcessMetrics(sim->metrics, &process->metrics);
+    sim->cores[process->core].currentProcess = NULL;
+    logProcessEvent(sim, logTime, endCode, process->id, NULL);
+    logProcessEvent(sim, logTime, LOG_PROCESS_EXIT, process->id, NULL);
+    releaseProcess(sim, process);
 }
 
 /**
- * Spawn a timer thread that runs for the provided time
+ * Hand an op of the running process to its device and block the process until the device is done
+ * @param sim simulator state
+ * @param process running process
+ * @param op dev op code
+ * @param ioTime device time of the op
+ * @param logTime simulation time of the op
  */
-void spawnTimerThread(long time) {
-    pthread_t threadId;
-    pthread_create(&threadId, NULL, timerThread, &time);
-    pthread_join(threadId, NULL);
+void blockOnDevice(SimulatorType *sim, ProcessControlBlock *process, OpCodeType *op, long long ioTime,
+                   long long logTime) {
+    logProcessEvent(sim, logTime, LOG_IO_START, process->id, op);
+
+    // a virtual device finishes through the event queue
+    long long endTime = submitDeviceOp(sim->devicePool, process->id, op, getIdealTime(&sim->clock), ioTime);
+    if (sim->clock.mode == CLOCK_VIRTUAL_CODE) {
+        scheduleEvent(sim->eventQueue, endTime, EVT_IO_END, process->id, op);
+    }
+    sim->pendingDeviceOps++;
+
+    // block the process so the cpu can run another one
+    unqueueProcess(sim, process);
+    process->state = BLOCKED;
+    process->blockStart = getIdealTime(&sim->clock);
+    sim->cores[process->core].currentProcess = NULL;
+    logProcessEvent(sim, logTime, LOG_PROCESS_BLOCKED, process->id, NULL);
 }
 
 /**
- * Run a process specific command for a given process
+ * Run a memory op of the running process, a failed allocate or access ends the process.
+ * With paging on, an access that faults blocks the process while the hard drive loads its pages.
+ * @param sim simulator state
+ * @param process running process
+ * @param op mem op code
+ * @param logTime simulation time of the op
+ */
+void runMemoryOp(SimulatorType *sim, ProcessControlBlock *process, OpCodeType *op, long long logTime) {
+    Boolean succeeded;
+    if (op->argCode == ARG_ALLOCATE) {
+        logProcessEvent(sim, logTime, LOG_MEM_ALLOCATE_REQUEST, process->id, op);
+        succeeded = allocateMemory(sim->memory, process->id, op->intArg2, op->intArg3, &process->segments);
+        logProcessEvent(sim, logTime, succeeded == True ? LOG_MEM_ALLOCATE_SUCCESS : LOG_MEM_ALLOCATE_FAILURE,
+                        process->id, NULL);
+    } else {
+        logProcessEvent(sim, logTime, LOG_MEM_ACCESS_REQUEST, process->id, op);
+        succeeded = accessMemory(sim->memory, process->id, op->intArg2, op->intArg3);
+        logProcessEvent(sim, logTime, succeeded == True ? LOG_MEM_ACCESS_SUCCESS : LOG_MEM_ACCESS_FAILURE,
+                        process->id, NULL);
+    }
+    if (succeeded == False) {
+        exitProcess(sim, process, LOG_SEGFAULT, logTime);
+    } else if (op->argCode == ARG_ACCESS && sim->memory->pages != NULL) {
+        int faultCount = accessPages(sim->memory->pages, process->id, op->intArg2, op->intArg3);
+        if (faultCount > 0) {
+            OpCodeType faultOp = {process->id, CMD_MEM, IO_NONE, ARG_ACCESS, faultCount, 0, 0.0};
+            long long ioTime = (long long) faultCount * sim->configDataPtr->pageFaultCycles
+                               * sim->configDataPtr->ioCycleRate * 1000LL;
+            logProcessEvent(sim, logTime, LOG_PAGE_FAULT, process->id, &faultOp);
+            blockOnDevice(sim, process, &sim->pageFaultOp, ioTime, logTime);
+        }
+    }
+}
+
+/**
+ * Start the next op of the process running on a core.
+ * cpu ops keep the core busy until their end event, dev ops block the process until the device is done.
  *
- * @param configDataPtr config data
- * @param startTime start time of the OS simulator
- * @param logFile file pointer to log to
- * @param logF boolean for logging to the file
- * @param logS boolean for logging to stdout
- * @param selectedProcess the currently selected process
- * @param currentOp current op code
- */
-void runProcessCommand(
-        ConfigDataType *configDataPtr, struct timeval startTime, FILE *logFile, int logF, int logS,
-        ProcessControlBlock *selectedProcess, OpCodeType *currentOp) {
-    if (compareString(currentOp->command, "dev") == STR_EQ) {
-        // we are handling a device op code
-        // format: "dev XXX, XXX, #"
-        long ioTime = currentOp->intArg2 * configDataPtr->ioCycleRate;
-        struct timeval elapsedTime = timeDiff(startTime);
-        LOGGER("  %ld.%06ld, Process: %d, %s %sput operation start\n", elapsedTime.tv_sec,
-               elapsedTime.tv_usec, selectedProcess->id, currentOp->strArg1, currentOp->inOutArg);
-
-        // run the time in another thread
-        spawnTimerThread(ioTime);
-
-        elapsedTime = timeDiff(startTime);
-        LOGGER("  %ld.%06ld, Process: %d, %s %sput operation end\n", elapsedTime.tv_sec,
-               elapsedTime.tv_usec, selectedProcess->id, currentOp->strArg1, currentOp->inOutArg);
-    } else if (compareString(currentOp->command, "cpu") == STR_EQ) {
-        // we are handling a cpu op code
-        // format: "cpu XXX, #"
-        if (compareString(currentOp->strArg1, "process") == STR_EQ) {
-            struct timeval elapsedTime = timeDiff(startTime);
-            LOGGER("  %ld.%06ld, Process: %d, cpu process operation start\n", elapsedTime.tv_sec,
-                   elapsedTime.tv_usec, selectedProcess->id);
-
-            // run the time in another thread
-            long processTime = currentOp->intArg2 * configDataPtr->procCycleRate;
-            spawnTimerThread(processTime);
-
-            elapsedTime = timeDiff(startTime);
-            LOGGER("  %ld.%06ld, Process: %d, cpu process operation end\n", elapsedTime.tv_sec,
-                   elapsedTime.tv_usec, selectedProcess->id);
+ * @param sim simulator state
+ * @param core core of the running process
+ */
+void runProcessCommand(SimulatorType *sim, CoreType *core) {
+    ConfigDataType *configDataPtr = sim->configDataPtr;
+    ProcessControlBlock *selectedProcess = core->currentProcess;
+    OpCodeType *currentOp = selectedProcess->currentOp;
+    long long logTime = getSimTime(&sim->clock);
+    // a cpu op stays the current op until its last slice has run
+    if (currentOp->commandCode != CMD_CPU || currentOp->argCode != ARG_PROCESS) {
+        selectedProcess->currentOp++;
+    }
+
+    if (currentOp == selectedProcess->endOp) {
+        // we are handling the app end op code of the process
+        // format: "app end"
+        exitProcess(sim, selectedProcess, LOG_PROCESS_ENDED, logTime);
+        return;
+    }
+
+    switch (currentOp->commandCode) {
+        case CMD_DEV: {
+            // we are handling a device op code
+            // format: "dev XXX, XXX, #"
+            if (getDeviceIndex(currentOp->argCode) == DEVICE_NOT_FOUND) {
+                // this should never happen!
+                printf("    unhandled device %s\n", getArgName(currentOp->argCode));
+                break;
+            }
+            long long ioTime = getOpTime(configDataPtr, currentOp);
+            selectedProcess->remainingTime -= ioTime;
+            blockOnDevice(sim, selectedProcess, currentOp, ioTime, logTime);
+            break;
         }
+        case CMD_CPU:
+            // we are handling a cpu op code
+            // format: "cpu XXX, #"
+            if (currentOp->argCode == ARG_PROCESS) {
+                // a sliced op goes on with the time it has left
+                if (selectedProcess->opTimeLeft == 0) {
+                    selectedProcess->opTimeLeft = getOpTime(configDataPtr, currentOp);
+                    logCpuEvent(sim, logTime, LOG_CPU_START, selectedProcess, core);
+                }
+
+                // keep the cpu busy until the end of the op, or of the quantum when the cpu is preemptive
+                long long sliceTime = selectedProcess->opTimeLeft;
+                long long quantumTime = (long long) configDataPtr->quantumCycles * configDataPtr->procCycleRate * 1000LL;
+                if (isPreemptive(configDataPtr->cpuSchedCode) == True && quantumTime > 0 && sliceTime > quantumTime) {
+                    sliceTime = quantumTime;
+                }
+                // a process whose last cpu slice ran on another core first warms this one up
+                long long penaltyTime = 0;
+                if (selectedProcess->lastCore >= 0 && selectedProcess->lastCore != core->id) {
+                    penaltyTime = (long long) configDataPtr->migrationCycles * configDataPtr->procCycleRate * 1000LL;
+                    core->migrationCount++;
+                    core->migrationTime += penaltyTime;
+                }
+                selectedProcess->lastCore = core->id;
+                core->busyStart = getIdealTime(&sim->clock);
+                selectedProcess->sliceStart = core->busyStart + penaltyTime;
+                selectedProcess->sliceEnd = selectedProcess->sliceStart + sliceTime;
+                scheduleEvent(sim->eventQueue, selectedProcess->sliceEnd, EVT_CPU_END, selectedProcess->id, currentOp);
+                core->busy = True;
+            }
+            break;
+        case CMD_MEM:
+            // we are handling a memory op code
+            // format: "mem XXX, #, #"
+            runMemoryOp(sim, selectedProcess, currentOp, logTime);
+            break;
+        default:
+            break;
     }
 }
 
 /**
- * Runs the simulator
- * @param configDataPtr Config Data
- * @param metaDataPtr Metadata / op code list
+ * End the cpu slice running on a core, finishing its op if that was the last of it
+ * @param sim simulator state
+ * @param core core the slice ran on
+ */
+void endCpuSlice(SimulatorType *sim, CoreType *core) {
+    ProcessControlBlock *process = core->currentProcess;
+    long long sliceTime = process->sliceEnd - process->sliceStart;
+
+    process->opTimeLeft -= sliceTime;
+    process->remainingTime -= sliceTime;
+    process->metrics.cpuTime += sliceTime;
+    process->sliceEnd = -1;
+    endBusyTime(sim, core);
+    if (process->opTimeLeft == 0) {
+        logCpuEvent(sim, getSimTime(&sim->clock), LOG_CPU_END, process, core);
+        process->currentOp++;
+    }
+    // every slice boundary is a quantum boundary
+    if (sim->configDataPtr->cpuSchedCode == CPU_SCHED_RR_P_CODE) {
+        expireQuantum(sim, core);
+    } else {
+        preemptRunningProcess(sim, core);
+    }
+}
+
+/**
+ * Wait for the next thing to happen in the simulation: a scheduled event or a finished device op
+ * @param sim simulator state
+ * @return False if there is nothing left to wait for
  */
-void runSim(ConfigDataType *configDataPtr, OpCodeType *metaDataPtr) {
-    printf("Simulator Run\n-------------\n\n");
-    // TODO: remove for Sim03
-    configDataPtr->cpuSchedCode = CPU_SCHED_FCFS_N_CODE;
+Boolean waitForNextEvent(SimulatorType *sim) {
+    SimEventType event;
+    Boolean hasEvent = peekEvent(sim->eventQueue, &event);
 
-    ProcessControlBlock *pcb = createProcessControlBlocks(metaDataPtr);
-    struct timeval startTime;
-    gettimeofday(&startTime, NULL);
-    FILE *logFile;
+    if (sim->clock.mode == CLOCK_REAL_CODE) {
+        if (hasEvent == False && sim->pendingDeviceOps == 0) {
+            return False;
+        }
+        // device workers may finish before the next event, leave the last stretch for the clock to spin
+        long long deadline = hasEvent == True ? event.time - TIMER_SPIN_USEC : -1;
+        if (waitForDeviceCompletion(sim->devicePool, deadline) == True) {
+            return True;
+        }
+    }
 
-    // booleans for where we need to log
-    int logF = configDataPtr->logToCode == LOGTO_BOTH_CODE || configDataPtr->logToCode == LOGTO_FILE_CODE;
-    int logS = configDataPtr->logToCode == LOGTO_BOTH_CODE || configDataPtr->logToCode == LOGTO_MONITOR_CODE;
+    if (popEvent(sim->eventQueue, &event) == False) {
+        return False;
+    }
+    // the slice of a process that was interrupted by a device ended early
+    ProcessControlBlock *process = NULL;
+    if (event.code == EVT_CPU_END) {
+        process = findProcess(sim, event.pid);
+        if (process == NULL || process->id != event.pid || process->state != RUNNING
+            || process->sliceEnd != event.time) {
+            return True;
+        }
+    }
+    advanceSimClock(&sim->clock, event.time);
+    if (event.code == EVT_CPU_END) {
+        endCpuSlice(sim, &sim->cores[process->core]);
+    } else if (event.code == EVT_IO_END) {
+        completeDeviceOp(sim, event.pid, event.op);
+    }
+    return True;
+}
 
-    // if we need to log to a file, open it
-    if (logF) {
-        logFile = fopen(configDataPtr->logToFileName, "w");
+/**
+ * Fill a run summary from the final simulator state
+ * @param sim simulator state
+ * @param resultPtr run summary
+ * @param completed False when the simulator stalled before every process exited
+ */
+void fillSimResult(SimulatorType *sim, SimResultType *resultPtr, Boolean completed) {
+    resultPtr->endTime = getSimTime(&sim->clock);
+    resultPtr->processCount = sim->processCount;
+    resultPtr->exitCount = sim->exitCount;
+    resultPtr->segfaultCount = sim->segfaultCount;
+    resultPtr->busyTime = 0;
+    for (int index = 0; index < sim->coreCount; index++) {
+        resultPtr->busyTime += sim->cores[index].busyTime;
     }
+    resultPtr->pageFaultCount = sim->memory->pages != NULL ? sim->memory->pages->total.faultCount : 0;
+    resultPtr->contextSwitchCount = sim->metrics->contextSwitchCount;
+    summarizeProcessMetrics(sim->metrics, &resultPtr->turnaround, &resultPtr->waiting, &resultPtr->response);
+    resultPtr->completed = completed;
+}
+
+/**
+ * Run the simulator on a loaded program or on a metadata stream
+ * @param configDataPtr Config Data
+ * @param programPtr Metadata / op code program, NULL when streaming
+ * @param streamPtr metadata stream, NULL when running a loaded program
+ * @param resultPtr run summary to fill instead of printing one, NULL to print it
+ */
+void runSimulation(ConfigDataType *configDataPtr, OpProgramType *programPtr, MetaDataStreamType *streamPtr,
+                   SimResultType *resultPtr) {
+    Boolean completed = True;
+    if (resultPtr == NULL) {
+        printf("Simulator Run\n-------------\n\n");
+    }
+
+    SimulatorType simulator = {0};
+    SimulatorType *sim = &simulator;
+    sim->configDataPtr = configDataPtr;
+    sim->stream = streamPtr;
+    sim->streamOpen = streamPtr != NULL;
+    sim->processTableSize = 16;
+    if (programPtr != NULL) {
+        sim->pcbArray = createProcessControlBlocks(programPtr);
+        while (sim->processTableSize < programPtr->processCount) {
+            sim->processTableSize *= 2;
+        }
+    } else {
+        while (sim->processTableSize < STREAM_PROCESS_WINDOW * 2) {
+            sim->processTableSize *= 2;
+        }
+    }
+    sim->processTable = calloc(sim->processTableSize, sizeof(ProcessControlBlock *));
+    sim->eventQueue = createEventQueue(16);
+    sim->coreCount = configDataPtr->cpuCores;
+    sim->cores = calloc(sim->coreCount, sizeof(CoreType));
+    for (int index = 0; index < sim->coreCount; index++) {
+        sim->cores[index].id = index;
+        sim->cores[index].lastPid = -1;
+        sim->cores[index].readyQueue = createReadyQueue(sim->processTableSize / sim->coreCount);
+        sim->cores[index].readyRing = createReadyRing(sim->processTableSize / sim->coreCount);
+    }
+    sim->memory = createMemoryManager(configDataPtr);
+    sim->metrics = createSimMetrics();
+    sim->pageFaultOp = (OpCodeType) {0, CMD_DEV, IO_IN, ARG_HARD_DRIVE, 0, 0, 0.0};
+    startSimClock(&sim->clock, configDataPtr->clockModeCode);
+    // only a run that prints can show how much of it went to the simulator itself
+    if (resultPtr == NULL && configDataPtr->recordOverhead == True) {
+        sim->overhead = createSimOverhead();
+        sim->clock.waitStats = &sim->overhead->clockWaits;
+    }
+    sim->devicePool = createDevicePool(&sim->clock, sim->overhead);
+
     // let the user know we're outputting to a file
-    if (!logS) {
+    if (resultPtr == NULL
+        && (configDataPtr->logToCode == LOGTO_FILE_CODE || configDataPtr->logToCode == LOGTO_TRACE_CODE)) {
         printf("Simulator running with output to file\n\n");
     }
+    // log lines are formatted and written by the logger's own thread
+    sim->logger = createSimLogger(configDataPtr->logToCode, configDataPtr->logToFileName, configDataPtr->logFullCode,
+                                  sim->overhead);
 
-    ProcessControlBlock *currentProcess = NULL;
-
-    // loop over all the op codes
-    OpCodeType *currentOp = metaDataPtr;
-    while (currentOp != NULL) {
-        struct timeval elapsedTime = timeDiff(startTime);
-        if (compareString(currentOp->command, "sys") == STR_EQ) {
-            // we are handling a system op code
-            // format: "sys XXX"
-            if (compareString(currentOp->strArg1, "start") == STR_EQ) {
-                LOGGER("  %ld.%06ld, OS: Simulator start\n", elapsedTime.tv_sec, elapsedTime.tv_usec);
-                // set all the pcbs to ready
-                ProcessControlBlock *selectedPcb = pcb;
-                while (selectedPcb != NULL) {
-                    selectedPcb->state = READY;
-                    LOGGER("  %ld.%06ld, OS: Process %d set to READY state from NEW state\n", elapsedTime.tv_sec,
-                           elapsedTime.tv_usec, selectedPcb->id);
-                    selectedPcb = selectedPcb->next;
-                }
-            } else if (compareString(currentOp->strArg1, "end") == STR_EQ) {
-                LOGGER("  %ld.%06ld, OS: Simulator end\n", elapsedTime.tv_sec, elapsedTime.tv_usec);
+    logProcessEvent(sim, getSimTime(&sim->clock), LOG_SIM_START, 0, NULL);
+    // set all the pcbs of a loaded program to ready
+    if (programPtr != NULL) {
+        for (int index = 0; index < programPtr->processCount; index++) {
+            admitProcess(sim, &sim->pcbArray[index]);
+        }
+    }
+
+    // run until every process has exited
+    while (admitProcesses(sim) == True) {
+        handleInterrupts(sim);
+
+        // dispatch a process on every free core, then start the next op of every running process
+        Boolean ranCommand = False;
+        Boolean allIdle = True;
+        for (int index = 0; index < sim->coreCount; index++) {
+            CoreType *core = &sim->cores[index];
+            if (core->currentProcess == NULL) {
+                dispatchProcess(sim, core);
             }
-        } else if (compareString(currentOp->command, "app") == STR_EQ) {
-            // we are handling an application op code
-            // format: "app XXX, ?#"
-            if (compareString(currentOp->strArg1, "start") == STR_EQ) {
-                currentProcess = selectProcess(configDataPtr->cpuSchedCode, pcb);
-                currentProcess->state = RUNNING;
-                LOGGER("  %ld.%06ld, OS: Process %d set from READY to RUNNING\n\n", elapsedTime.tv_sec,
-                       elapsedTime.tv_usec, currentProcess->id);
-            } else if (compareString(currentOp->strArg1, "end") == STR_EQ) {
-                if (currentProcess != NULL) {
-                    // end the current process
-                    currentProcess->state = EXIT;
-                    LOGGER("\n  %ld.%06ld, OS: Process %d ended\n", elapsedTime.tv_sec,
-                           elapsedTime.tv_usec, currentProcess->id);
-                    LOGGER("  %ld.%06ld, OS: Process %d set to EXIT\n", elapsedTime.tv_sec,
-                           elapsedTime.tv_usec, currentProcess->id);
-                    currentProcess = NULL;
-                }
+            if (core->currentProcess != NULL && core->busy == False) {
+                runProcessCommand(sim, core);
+                ranCommand = True;
             }
-        } else if (compareString(currentOp->command, "dev") == STR_EQ
-                   || compareString(currentOp->command, "cpu") == STR_EQ
-                   || compareString(currentOp->command, "mem") == STR_EQ) {
-            // we are handling a process specific op code
-            runProcessCommand(configDataPtr, startTime, logFile, logF, logS, currentProcess, currentOp);
-        } else {
+            if (core->currentProcess != NULL) {
+                allIdle = False;
+            }
+        }
+        if (ranCommand == True) {
+            continue;
+        }
+
+        if (allIdle == True && sim->cpuIdle == False) {
+            sim->cpuIdle = True;
+            logProcessEvent(sim, getSimTime(&sim->clock), LOG_CPU_IDLE, 0, NULL);
+        }
+        if (waitForNextEvent(sim) == False) {
             // this should never happen!
-            printf("    unhandled op code type %s\n", currentOp->command);
+            completed = False;
+            if (resultPtr == NULL) {
+                printf("    simulator stalled with %d processes left\n", sim->processCount - sim->exitCount);
+            }
+            break;
         }
-        currentOp = currentOp->nextNode;
     }
 
-    // close the file if we've opened it
-    if (logFile != NULL) {
-        fclose(logFile);
+    logProcessEvent(sim, getSimTime(&sim->clock), LOG_SIM_END, 0, NULL);
+    // flush the log before anything else is printed
+    sim->logger = closeSimLogger(sim->logger);
+    if (resultPtr != NULL) {
+        fillSimResult(sim, resultPtr, completed);
+        // a batch run exports its metrics next to its own log, without displaying them
+        if (configDataPtr->metricsCode == METRICS_CSV_CODE || configDataPtr->metricsCode == METRICS_JSON_CODE) {
+            char metricsFileName[MAX_STR_LEN];
+            getMetricsFileName(configDataPtr->logToFileName, configDataPtr->metricsCode, metricsFileName);
+            writeProcessMetrics(sim->metrics, configDataPtr->metricsCode, metricsFileName);
+        }
+    } else {
+        displayClockDrift(&sim->clock);
+        displayInterruptLatency(sim);
+        displayPhysicalMemory(sim->memory->physical);
+        displayPageTable(sim->memory->pages);
+        displayCoreUtilization(sim);
+        displayRunMetrics(sim);
     }
 
-    // free the pcb
-    ProcessControlBlock *tempPcb;
-    while (pcb != NULL) {
-        tempPcb = pcb;
-        pcb = pcb->next;
-        free(tempPcb);
+    sim->devicePool = clearDevicePool(sim->devicePool);
+    // the device workers' timings are in once they are joined
+    if (sim->overhead != NULL) {
+        displaySimOverhead(sim->overhead);
+        sim->overhead = clearSimOverhead(sim->overhead);
+    }
+    sim->eventQueue = clearEventQueue(sim->eventQueue);
+    for (int index = 0; index < sim->coreCount; index++) {
+        sim->cores[index].readyQueue = clearReadyQueue(sim->cores[index].readyQueue);
+        sim->cores[index].readyRing = clearReadyRing(sim->cores[index].readyRing);
     }
+    free(sim->cores);
+    sim->memory = clearMemoryManager(sim->memory);
+    sim->metrics = clearSimMetrics(sim->metrics);
+    // free the pcbs, streamed pcbs still running after a metadata error go with the process table
+    for (int index = 0; index < sim->processTableSize; index++) {
+        ProcessControlBlock *process = sim->processTable[index];
+        if (process != NULL && process->block != NULL) {
+            clearProcessBlock(process->block);
+            free(process);
+        }
+    }
+    free(sim->processTable);
+    free(sim->pcbArray);
 }
 
-#undef LOGGER
+/**
+ * Runs the simulator
+ * @param configDataPtr Config Data
+ * @param programPtr Metadata / op code program
+ */
+void runSim(ConfigDataType *configDataPtr, OpProgramType *programPtr) {
+    runSimulation(configDataPtr, programPtr, NULL, NULL);
+}
+
+/**
+ * Runs the simulator while the metadata is still being parsed.
+ * Processes are admitted as their blocks arrive, with at most STREAM_PROCESS_WINDOW of them in memory.
+ * @param configDataPtr Config Data
+ * @param streamPtr metadata stream
+ */
+void runSimStream(ConfigDataType *configDataPtr, MetaDataStreamType *streamPtr) {
+    runSimulation(configDataPtr, NULL, streamPtr, NULL);
+}
+
+/**
+ * Runs the simulator without printing anything, so several runs can share the console.
+ * The config has to log to a file, the summary goes to resultPtr.
+ * @param configDataPtr Config Data
+ * @param programPtr Metadata / op code program, only read by the run
+ * @param resultPtr run summary
+ */
+void runSimQuiet(ConfigDataType *configDataPtr, OpProgramType *programPtr, SimResultType *resultPtr) {
+    runSimulation(configDataPtr, programPtr, NULL, resultPtr);
+}
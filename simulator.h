@@ -6,20 +6,114 @@
 #include "StringUtils.h"
 #include "metadataops.h"
 #include "configops.h"
+#include "simclock.h"
+#include "eventqueue.h"
+#include "devicepool.h"
+#include "metadatastream.h"
+#include "simlog.h"
+#include "readyqueue.h"
+#include "memorymanager.h"
+#include "simmetrics.h"
+
+// GLOBAL CONSTANTS
+extern const int STREAM_PROCESS_WINDOW;
 
 typedef enum {
     NEW,
     READY,
     RUNNING,
+    BLOCKED,
     EXIT
 } ProcessState;
 
 typedef struct ProcessControlBlock {
     int id;
     ProcessState state;
-    struct ProcessControlBlock *next;
+    OpCodeType *currentOp;
+    OpCodeType *endOp;
+    long long remainingTime;
+    long long opTimeLeft;
+    long long sliceStart;
+    long long sliceEnd;
+    int readyIndex;
+    int core;
+    // core of the last cpu slice, -1 before the first one
+    int lastCore;
+    long long readyStart;
+    long long blockStart;
+    ProcessMetricsType metrics;
+    MemorySegmentType *segments;
+    ProcessBlockType *block;
 } ProcessControlBlock;
 
-void runSim(ConfigDataType *configDataPtr, OpCodeType *metaDataPtr);
+/**
+ * One simulated cpu core with its own run queue. Only the queue that fits the scheduling code is used.
+ */
+typedef struct CoreType {
+    int id;
+    ReadyQueueType *readyQueue;
+    ReadyRingType *readyRing;
+    ProcessControlBlock *currentProcess;
+    int lastPid;
+    Boolean busy;
+    long long busyStart;
+    long long busyTime;
+    long long migrationTime;
+    int migrationCount;
+    int stealCount;
+} CoreType;
+
+/**
+ * Summary of one simulator run, filled in place of the printed summary when runs are batched
+ */
+typedef struct SimResultType {
+    long long endTime;
+    int processCount;
+    int exitCount;
+    int segfaultCount;
+    long long busyTime;
+    long long pageFaultCount;
+    long long contextSwitchCount;
+    MetricSummaryType turnaround;
+    MetricSummaryType waiting;
+    MetricSummaryType response;
+    Boolean completed;
+} SimResultType;
+
+/**
+ * State of one simulator run
+ */
+typedef struct SimulatorType {
+    ConfigDataType *configDataPtr;
+    SimClockType clock;
+    EventQueueType *eventQueue;
+    DevicePoolType *devicePool;
+    MetaDataStreamType *stream;
+    Boolean streamOpen;
+    Boolean streamFailed;
+    ProcessControlBlock *pcbArray;
+    ProcessControlBlock **processTable;
+    int processTableSize;
+    CoreType *cores;
+    int coreCount;
+    MemoryManagerType *memory;
+    OpCodeType pageFaultOp;
+    int processCount;
+    int exitCount;
+    int segfaultCount;
+    int pendingDeviceOps;
+    Boolean cpuIdle;
+    SimLoggerType *logger;
+    SimMetricsType *metrics;
+    SimOverheadType *overhead;
+    long long interruptCount;
+    long long totalInterruptLatency;
+    long long maxInterruptLatency;
+    long long totalPostLatency;
+} SimulatorType;
+
+void runSim(ConfigDataType *configDataPtr, OpProgramType *programPtr);
+void runSimStream(ConfigDataType *configDataPtr, MetaDataStreamType *streamPtr);
+void runSimQuiet(ConfigDataType *configDataPtr, OpProgramType *programPtr, SimResultType *resultPtr);
 
 #endif
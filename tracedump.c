@@ -0,0 +1,38 @@
+#include "datatypes.h"
+#include "StringUtils.h"
+#include "simlog.h"
+#include "simtrace.h"
+
+/**
+ * Decode a binary simulator trace back into the text log.
+ * Only the log lines are printed, so the output matches a "Log To: File" log line for line.
+ * An optional time range, in seconds of simulation time, limits the lines to that slice of the run.
+ */
+int main(int argc, char **argv) {
+    char line[LOG_LINE_MAX];
+    LogRecordType record;
+
+    if (argc < 2) {
+        printf("Program Format:\n");
+        printf("     tracedump <trace file> [start time] [end time]\n");
+        return 1;
+    }
+    long long startTime = argc > 2 ? (long long) (atof(argv[2]) * 1000000.0) : 0;
+    long long endTime = argc > 3 ? (long long) (atof(argv[3]) * 1000000.0) : -1;
+
+    TraceReaderType *reader = openTraceReader(argv[1]);
+    if (reader == NULL) {
+        printf("Trace file %s is missing or not a simulator trace\n", argv[1]);
+        return 1;
+    }
+    while (readTraceRecord(reader, &record) == True) {
+        if (endTime >= 0 && record.time > endTime) {
+            break;
+        }
+        if (record.time >= startTime) {
+            fwrite(line, 1, formatLogRecord(&record, line, LOG_LINE_MAX), stdout);
+        }
+    }
+    closeTraceReader(reader);
+    return 0;
+}